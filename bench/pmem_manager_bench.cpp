@@ -0,0 +1,589 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// C++ standard libraries
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// system libraries
+#include <sys/stat.h>
+
+// external system libraries
+#include <libpmemobj.h>
+
+// external libraries
+#include "gflags/gflags.h"
+
+// local sources
+#include "pmem/memory/epoch_based_gc.hpp"
+#include "pmem/memory/utility.hpp"
+
+/*##############################################################################
+ * Command line arguments
+ *############################################################################*/
+
+DEFINE_string(pmem_dir, "", "The path to a directory on persistent memory");
+DEFINE_uint64(num_exec, 1000000, "The number of operations performed by each thread");
+DEFINE_uint64(num_thread, 1, "The number of worker threads");
+DEFINE_uint64(gc_interval, 100000, "The interval of garbage collection [us]");
+DEFINE_uint64(gc_thread, 1, "The number of cleaner threads");
+DEFINE_uint64(gc_watermark, 0, "The number of garbage per thread to trigger GC (0: disabled)");
+DEFINE_uint64(page_size, 64, "The size of each garbage page [bytes]");
+DEFINE_uint64(pool_size, PMEMOBJ_MIN_POOL * 128, "The capacity of a pool for pages [bytes]");
+DEFINE_uint64(gc_size, PMEMOBJ_MIN_POOL * 16, "The capacity of a pool for GC [bytes]");
+DEFINE_bool(release, true, "Measure a target that releases garbage immediately");
+DEFINE_bool(reuse, true, "Measure a target that reuses garbage pages");
+DEFINE_uint64(batch_size, 1, "The number of garbage added at once by AddGarbages (1: AddGarbage)");
+DEFINE_string(output_format, "csv", "The format of results (csv/json)");
+DEFINE_bool(csv_header, true, "Print a header line for CSV outputs");
+
+namespace
+{
+auto
+ValidatePositive(  //
+    const char *flagname,
+    const uint64_t value)  //
+    -> bool
+{
+  if (value > 0) return true;
+  std::cerr << "A value must be positive for " << flagname << std::endl;
+  return false;
+}
+
+auto
+ValidatePageSize(  //
+    [[maybe_unused]] const char *flagname,
+    const uint64_t value)  //
+    -> bool
+{
+  if (value >= ::dbgroup::pmem::memory::kWordSize) return true;
+  std::cerr << "A page must have at least " << ::dbgroup::pmem::memory::kWordSize << " bytes"
+            << std::endl;
+  return false;
+}
+
+auto
+ValidateBatchSize(  //
+    [[maybe_unused]] const char *flagname,
+    const uint64_t value)  //
+    -> bool
+{
+  if (value > 0 && value <= ::dbgroup::pmem::memory::kTmpFieldNum) return true;
+  std::cerr << "A batch size must be in [1, " << ::dbgroup::pmem::memory::kTmpFieldNum << "]"
+            << std::endl;
+  return false;
+}
+
+auto
+ValidateOutputFormat(  //
+    [[maybe_unused]] const char *flagname,
+    const std::string &value)  //
+    -> bool
+{
+  if (value == "csv" || value == "json") return true;
+  std::cerr << "An output format must be csv or json" << std::endl;
+  return false;
+}
+
+}  // namespace
+
+DEFINE_validator(num_exec, &ValidatePositive);
+DEFINE_validator(num_thread, &ValidatePositive);
+DEFINE_validator(gc_interval, &ValidatePositive);
+DEFINE_validator(gc_thread, &ValidatePositive);
+DEFINE_validator(page_size, &ValidatePageSize);
+DEFINE_validator(batch_size, &ValidateBatchSize);
+DEFINE_validator(output_format, &ValidateOutputFormat);
+
+namespace dbgroup::pmem::memory::bench
+{
+/*##############################################################################
+ * Global type aliases and constants
+ *############################################################################*/
+
+using Clock_t = ::std::chrono::steady_clock;
+
+constexpr const char *kPoolName = "pmem_manager_bench";
+constexpr const char *kGCName = "pmem_manager_bench_gc";
+constexpr const char *kLayout = "pmem_manager_bench";
+constexpr auto kModeRW = S_IRUSR | S_IWUSR;  // NOLINT
+
+/*##############################################################################
+ * Utilities for measuring reclamation lag
+ *############################################################################*/
+
+/**
+ * @brief A class for gathering the delay between AddGarbage and reclamation.
+ *
+ * Cleaner threads call destructors of garbage, so each cleaner records delays
+ * in its own buffer and this class gathers them after measurement.
+ */
+class LagRecorder
+{
+ public:
+  /**
+   * @brief Start/stop recording reclamation delays.
+   *
+   * @param is_recording A flag for enabling recording.
+   */
+  static void
+  SetRecording(const bool is_recording)
+  {
+    IsRecording().store(is_recording, std::memory_order_release);
+  }
+
+  /**
+   * @brief Record a reclamation delay if needed.
+   *
+   * @param added_at A timestamp when a target page was added to GC.
+   */
+  static void
+  Record(const uint64_t added_at)
+  {
+    if (!IsRecording().load(std::memory_order_acquire)) return;
+
+    const auto now = GetTimestamp();
+    auto *buf = GetLocalBuffer();
+    [[maybe_unused]] std::lock_guard guard{buf->mtx};
+    buf->lags.emplace_back(now - added_at);
+  }
+
+  /**
+   * @brief Gather and clear recorded delays.
+   *
+   * @return The recorded delays in nanoseconds.
+   */
+  static auto
+  Gather()  //
+      -> std::vector<uint64_t>
+  {
+    std::vector<uint64_t> lags{};
+    [[maybe_unused]] std::lock_guard guard{GetBuffers().mtx};
+    for (auto &&buf : GetBuffers().list) {
+      [[maybe_unused]] std::lock_guard buf_guard{buf->mtx};
+      lags.insert(lags.end(), buf->lags.begin(), buf->lags.end());
+      buf->lags.clear();
+    }
+    return lags;
+  }
+
+  /**
+   * @return The current timestamp in nanoseconds.
+   */
+  static auto
+  GetTimestamp()  //
+      -> uint64_t
+  {
+    const auto &now = Clock_t::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+  }
+
+ private:
+  /// @brief A thread-local buffer for recording delays.
+  struct Buffer {
+    std::mutex mtx{};
+    std::vector<uint64_t> lags{};
+  };
+
+  /// @brief A list of thread-local buffers.
+  struct BufferList {
+    std::mutex mtx{};
+    std::vector<std::unique_ptr<Buffer>> list{};
+  };
+
+  static auto
+  IsRecording()  //
+      -> std::atomic_bool &
+  {
+    static std::atomic_bool is_recording{false};
+    return is_recording;
+  }
+
+  static auto
+  GetBuffers()  //
+      -> BufferList &
+  {
+    static BufferList buffers{};
+    return buffers;
+  }
+
+  static auto
+  GetLocalBuffer()  //
+      -> Buffer *
+  {
+    thread_local Buffer *buf = nullptr;
+    if (buf == nullptr) {
+      auto &buffers = GetBuffers();
+      [[maybe_unused]] std::lock_guard guard{buffers.mtx};
+      buf = buffers.list.emplace_back(std::make_unique<Buffer>()).get();
+    }
+    return buf;
+  }
+};
+
+/**
+ * @brief A page header for recording when a page is added to GC.
+ *
+ */
+struct Payload {
+  ~Payload() { LagRecorder::Record(added_at); }
+
+  uint64_t added_at{};
+};
+
+/*##############################################################################
+ * Target classes
+ *############################################################################*/
+
+struct ReleaseTarget : public DefaultTarget {
+  using T = Payload;
+  static constexpr bool kReusePages = false;
+};
+
+struct ReuseTarget : public DefaultTarget {
+  using T = Payload;
+  static constexpr bool kReusePages = true;
+};
+
+using EpochBasedGC_t = EpochBasedGC<ReleaseTarget, ReuseTarget>;
+
+/*##############################################################################
+ * Utilities for reporting results
+ *############################################################################*/
+
+/**
+ * @brief A struct for holding results of each configuration.
+ *
+ */
+struct Result {
+  /**
+   * @param vals Sorted values.
+   * @param ratio A percentile in [0, 1].
+   * @return The value of the given percentile.
+   */
+  static auto
+  Percentile(  //
+      const std::vector<uint64_t> &vals,
+      const double ratio)  //
+      -> uint64_t
+  {
+    if (vals.empty()) return 0;
+    const auto pos = static_cast<size_t>(ratio * static_cast<double>(vals.size() - 1));
+    return vals.at(pos);
+  }
+
+  /**
+   * @brief Print a header line of CSV outputs.
+   *
+   */
+  static void
+  PrintCSVHeader()
+  {
+    std::cout << "target,thread_num,gc_interval_us,gc_thread_num,page_size,batch_size,operations,"
+                 "throughput_ops,latency_p50_ns,latency_p99_ns,latency_p999_ns,"
+                 "reuse_hit_rate,persist_per_op,"
+                 "lag_num,lag_p50_us,lag_p99_us,lag_p999_us,lag_max_us\n";
+  }
+
+  /**
+   * @brief Print results in a specified format.
+   *
+   */
+  void
+  Print() const
+  {
+    const auto ops = static_cast<double>(operations);
+    const auto throughput = ops / (static_cast<double>(exec_time_ns) / 1E9);
+    const auto hit_rate = static_cast<double>(reuse_hits) / ops;
+    const auto persist_rate = static_cast<double>(persist_num) / ops;
+    const auto lat50 = Percentile(latencies, 0.5);
+    const auto lat99 = Percentile(latencies, 0.99);
+    const auto lat999 = Percentile(latencies, 0.999);
+    const auto lag50 = Percentile(lags, 0.5) / 1000;
+    const auto lag99 = Percentile(lags, 0.99) / 1000;
+    const auto lag999 = Percentile(lags, 0.999) / 1000;
+    const auto lag_max = lags.empty() ? 0 : lags.back() / 1000;
+
+    if (FLAGS_output_format == "json") {
+      std::cout << "{\"target\":\"" << target << "\","                  //
+                << "\"thread_num\":" << FLAGS_num_thread << ","         //
+                << "\"gc_interval_us\":" << FLAGS_gc_interval << ","    //
+                << "\"gc_thread_num\":" << FLAGS_gc_thread << ","       //
+                << "\"page_size\":" << FLAGS_page_size << ","           //
+                << "\"batch_size\":" << FLAGS_batch_size << ","         //
+                << "\"operations\":" << operations << ","               //
+                << "\"throughput_ops\":" << throughput << ","           //
+                << "\"latency_p50_ns\":" << lat50 << ","                //
+                << "\"latency_p99_ns\":" << lat99 << ","                //
+                << "\"latency_p999_ns\":" << lat999 << ","              //
+                << "\"reuse_hit_rate\":" << hit_rate << ","             //
+                << "\"persist_per_op\":" << persist_rate << ","         //
+                << "\"lag_num\":" << lags.size() << ","                 //
+                << "\"lag_p50_us\":" << lag50 << ","                    //
+                << "\"lag_p99_us\":" << lag99 << ","                    //
+                << "\"lag_p999_us\":" << lag999 << ","                  //
+                << "\"lag_max_us\":" << lag_max << "}\n";
+    } else {
+      std::cout << target << ","               //
+                << FLAGS_num_thread << ","     //
+                << FLAGS_gc_interval << ","    //
+                << FLAGS_gc_thread << ","      //
+                << FLAGS_page_size << ","      //
+                << FLAGS_batch_size << ","     //
+                << operations << ","           //
+                << throughput << ","           //
+                << lat50 << ","                //
+                << lat99 << ","                //
+                << lat999 << ","               //
+                << hit_rate << ","             //
+                << persist_rate << ","         //
+                << lags.size() << ","          //
+                << lag50 << ","                //
+                << lag99 << ","                //
+                << lag999 << ","               //
+                << lag_max << "\n";
+    }
+  }
+
+  /// @brief The name of a measured target.
+  std::string target{};
+
+  /// @brief The total number of operations.
+  size_t operations{0};
+
+  /// @brief The execution time of all the workers.
+  uint64_t exec_time_ns{0};
+
+  /// @brief The number of reused pages.
+  size_t reuse_hits{0};
+
+  /// @brief The number of persistence operations on garbage lists.
+  size_t persist_num{0};
+
+  /// @brief Sorted latencies of each operation.
+  std::vector<uint64_t> latencies{};
+
+  /// @brief Sorted delays between AddGarbage and reclamation.
+  std::vector<uint64_t> lags{};
+};
+
+/*##############################################################################
+ * Benchmark procedures
+ *############################################################################*/
+
+/**
+ * @brief A class for measuring the performance of EpochBasedGC.
+ *
+ */
+class Bench
+{
+ public:
+  /**
+   * @brief Construct a new Bench object.
+   *
+   * @param pmem_dir The path to a working directory on persistent memory.
+   */
+  explicit Bench(const std::filesystem::path &pmem_dir)
+  {
+    pool_path_ = pmem_dir / kPoolName;
+    gc_path_ = pmem_dir / kGCName;
+    std::filesystem::remove(pool_path_);
+    std::filesystem::remove(gc_path_);
+
+    pop_ = pmemobj_create(pool_path_.c_str(), kLayout, FLAGS_pool_size, kModeRW);
+    if (pop_ == nullptr) {
+      throw std::runtime_error{pmemobj_errormsg()};
+    }
+  }
+
+  Bench(const Bench &) = delete;
+  Bench(Bench &&) = delete;
+
+  auto operator=(const Bench &) -> Bench & = delete;
+  auto operator=(Bench &&) -> Bench & = delete;
+
+  ~Bench()
+  {
+    pmemobj_close(pop_);
+    std::filesystem::remove(pool_path_);
+    std::filesystem::remove(gc_path_);
+  }
+
+  /**
+   * @brief Measure the performance of a given target.
+   *
+   * @tparam Target A target class of garbage collection.
+   * @param name The name of the target.
+   * @return Measured results.
+   */
+  template <class Target>
+  auto
+  Run(const std::string &name)  //
+      -> Result
+  {
+    Result res{};
+    res.target = name;
+    res.operations = FLAGS_num_exec * FLAGS_num_thread;
+
+    auto gc = std::make_unique<EpochBasedGC_t>(gc_path_, FLAGS_gc_size, kLayout, FLAGS_gc_interval,
+                                               FLAGS_gc_thread, FLAGS_gc_watermark);
+    gc->StartGC();
+    LagRecorder::SetRecording(true);
+
+    // run worker threads
+    std::vector<std::vector<uint64_t>> latencies(FLAGS_num_thread);
+    std::vector<size_t> hits(FLAGS_num_thread);
+    std::vector<std::thread> threads{};
+    std::atomic_bool is_ready{false};
+    for (size_t i = 0; i < FLAGS_num_thread; ++i) {
+      threads.emplace_back(&Bench::Worker<Target>, this, gc.get(), std::ref(is_ready),
+                           std::ref(latencies[i]), std::ref(hits[i]));
+    }
+    const auto start = Clock_t::now();
+    is_ready.store(true, std::memory_order_release);
+    for (auto &&t : threads) {
+      t.join();
+    }
+    const auto end = Clock_t::now();
+    res.exec_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    // wait for GC to reclaim the remaining garbage
+    std::this_thread::sleep_for(std::chrono::microseconds{FLAGS_gc_interval * 3});
+    LagRecorder::SetRecording(false);
+    res.persist_num = gc->GetStats<Target>().persist_num;
+    gc.reset(nullptr);
+
+    // summarize results
+    for (size_t i = 0; i < FLAGS_num_thread; ++i) {
+      res.reuse_hits += hits[i];
+      res.latencies.insert(res.latencies.end(), latencies[i].begin(), latencies[i].end());
+    }
+    std::sort(res.latencies.begin(), res.latencies.end());
+    res.lags = LagRecorder::Gather();
+    std::sort(res.lags.begin(), res.lags.end());
+
+    return res;
+  }
+
+ private:
+  /**
+   * @brief A worker procedure to add garbage pages.
+   *
+   * @tparam Target A target class of garbage collection.
+   * @param gc A garbage collector.
+   * @param is_ready A flag for starting measurement.
+   * @param latencies A buffer for recording latency.
+   * @param hits A counter for reused pages.
+   */
+  template <class Target>
+  void
+  Worker(  //
+      EpochBasedGC_t *gc,
+      const std::atomic_bool &is_ready,
+      std::vector<uint64_t> &latencies,
+      size_t &hits)
+  {
+    latencies.reserve(FLAGS_num_exec);
+    while (!is_ready.load(std::memory_order_acquire)) {
+      std::this_thread::yield();
+    }
+
+    const auto batch = FLAGS_batch_size;
+    for (size_t i = 0; i < FLAGS_num_exec; ++i) {
+      const auto start = Clock_t::now();
+      {
+        const auto &guard = gc->CreateEpochGuard();
+        auto *tmp_oids = gc->GetTmpField<Target>(0);
+        auto *tmp_oid = &(tmp_oids[i % batch]);
+        if constexpr (Target::kReusePages) {
+          gc->GetPageIfPossible<Target>(tmp_oid);
+          hits += OID_IS_NULL(*tmp_oid) ? 0 : 1;
+        }
+        if (OID_IS_NULL(*tmp_oid)) {
+          Malloc(pop_, tmp_oid, FLAGS_page_size);
+        }
+        auto *page = new (pmemobj_direct(*tmp_oid)) Payload{};
+        page->added_at = LagRecorder::GetTimestamp();
+        if (batch == 1) {
+          gc->AddGarbage<Target>(tmp_oid);
+        } else if (i % batch == batch - 1 || i == FLAGS_num_exec - 1) {
+          gc->AddGarbages<Target>(tmp_oids, i % batch + 1);
+        }
+      }
+      const auto end = Clock_t::now();
+      latencies.emplace_back(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+  }
+
+  /// @brief The path to a pmemobj pool for pages.
+  std::filesystem::path pool_path_{};
+
+  /// @brief The path to a pmemobj pool for GC.
+  std::filesystem::path gc_path_{};
+
+  /// @brief A pmemobj pool for pages.
+  PMEMobjpool *pop_{nullptr};
+};
+
+}  // namespace dbgroup::pmem::memory::bench
+
+/*##############################################################################
+ * Main function
+ *############################################################################*/
+
+auto
+main(  //
+    int argc,
+    char *argv[])  //
+    -> int
+{
+  using ::dbgroup::pmem::memory::bench::Bench;
+  using ::dbgroup::pmem::memory::bench::ReleaseTarget;
+  using ::dbgroup::pmem::memory::bench::Result;
+  using ::dbgroup::pmem::memory::bench::ReuseTarget;
+
+  gflags::SetUsageMessage("measures the throughput and reclamation lag of EpochBasedGC.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (FLAGS_pmem_dir.empty() || !std::filesystem::exists(FLAGS_pmem_dir)) {
+    std::cerr << "A valid path to persistent memory must be specified." << std::endl;
+    return 1;
+  }
+
+  Bench bench{FLAGS_pmem_dir};
+  if (FLAGS_output_format == "csv" && FLAGS_csv_header) {
+    Result::PrintCSVHeader();
+  }
+  if (FLAGS_release) {
+    bench.Run<ReleaseTarget>("release").Print();
+  }
+  if (FLAGS_reuse) {
+    bench.Run<ReuseTarget>("reuse").Print();
+  }
+
+  return 0;
+}
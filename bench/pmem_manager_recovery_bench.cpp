@@ -0,0 +1,640 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// C++ standard libraries
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// system libraries
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// external system libraries
+#include <libpmemobj.h>
+
+// external libraries
+#include "gflags/gflags.h"
+
+// local sources
+#include "pmem/memory/epoch_based_gc.hpp"
+#include "pmem/memory/utility.hpp"
+
+/*##############################################################################
+ * Command line arguments
+ *############################################################################*/
+
+DEFINE_string(pmem_dir, "", "The path to a directory on persistent memory");
+DEFINE_uint64(num_thread, 8, "The number of threads (i.e., TLSFields slots) that add garbage");
+DEFINE_uint64(num_garbage, 100000, "The number of garbage added by each thread before a crash");
+DEFINE_string(crash_point, "add", "The phase to be killed (add: AddGarbage, clear: cleaners)");
+DEFINE_uint64(kill_delay, 1000, "The delay after filling slots until SIGKILL [us]");
+DEFINE_bool(recover_in_background, false, "Release left garbage lists in the background");
+DEFINE_uint64(num_exec, 100000, "The number of garbage added by each thread to measure lag");
+DEFINE_uint64(stall_time, 0, "The duration of each stall of a reader thread (0: no reader) [us]");
+DEFINE_bool(interval_guard, false, "Use interval guards and birth epochs for a stalled reader");
+DEFINE_uint64(gc_interval, 100000, "The interval of garbage collection [us]");
+DEFINE_uint64(gc_thread, 1, "The number of cleaner threads");
+DEFINE_uint64(page_size, 64, "The size of each garbage page [bytes]");
+DEFINE_uint64(pool_size, PMEMOBJ_MIN_POOL * 128, "The capacity of a pool for pages [bytes]");
+DEFINE_uint64(gc_size, PMEMOBJ_MIN_POOL * 16, "The capacity of a pool for GC [bytes]");
+DEFINE_string(output_format, "csv", "The format of results (csv/json)");
+
+namespace
+{
+auto
+ValidatePositive(  //
+    const char *flagname,
+    const uint64_t value)  //
+    -> bool
+{
+  if (value > 0) return true;
+  std::cerr << "A value must be positive for " << flagname << std::endl;
+  return false;
+}
+
+auto
+ValidatePageSize(  //
+    [[maybe_unused]] const char *flagname,
+    const uint64_t value)  //
+    -> bool
+{
+  if (value >= ::dbgroup::pmem::memory::kWordSize) return true;
+  std::cerr << "A page must have at least " << ::dbgroup::pmem::memory::kWordSize << " bytes"
+            << std::endl;
+  return false;
+}
+
+auto
+ValidateCrashPoint(  //
+    [[maybe_unused]] const char *flagname,
+    const std::string &value)  //
+    -> bool
+{
+  if (value == "add" || value == "clear") return true;
+  std::cerr << "A crash point must be add or clear" << std::endl;
+  return false;
+}
+
+auto
+ValidateOutputFormat(  //
+    [[maybe_unused]] const char *flagname,
+    const std::string &value)  //
+    -> bool
+{
+  if (value == "csv" || value == "json") return true;
+  std::cerr << "An output format must be csv or json" << std::endl;
+  return false;
+}
+
+}  // namespace
+
+DEFINE_validator(num_thread, &ValidatePositive);
+DEFINE_validator(num_garbage, &ValidatePositive);
+DEFINE_validator(crash_point, &ValidateCrashPoint);
+DEFINE_validator(num_exec, &ValidatePositive);
+DEFINE_validator(gc_interval, &ValidatePositive);
+DEFINE_validator(gc_thread, &ValidatePositive);
+DEFINE_validator(page_size, &ValidatePageSize);
+DEFINE_validator(output_format, &ValidateOutputFormat);
+
+namespace dbgroup::pmem::memory::bench
+{
+/*##############################################################################
+ * Global type aliases and constants
+ *############################################################################*/
+
+using Clock_t = ::std::chrono::steady_clock;
+
+constexpr const char *kPoolName = "pmem_manager_recovery_bench";
+constexpr const char *kGCName = "pmem_manager_recovery_bench_gc";
+constexpr const char *kLayout = "pmem_manager_recovery_bench";
+constexpr auto kModeRW = S_IRUSR | S_IWUSR;  // NOLINT
+
+/// @brief The number of buckets of a lag histogram (the last one has no upper bound).
+constexpr size_t kBucketNum = 32;
+
+/*##############################################################################
+ * Utilities for measuring reclamation lag
+ *############################################################################*/
+
+/**
+ * @brief A class for counting delays between AddGarbage and reclamation.
+ *
+ * The i-th bucket counts delays in [2^(i-1), 2^i) microseconds, and cleaner
+ * threads update buckets with relaxed atomic increments.
+ */
+class LagHistogram
+{
+ public:
+  /**
+   * @brief Record a reclamation delay.
+   *
+   * @param added_at A timestamp when a target page was added to GC.
+   */
+  static void
+  Record(const uint64_t added_at)
+  {
+    const auto lag_us = (GetTimestamp() - added_at) / 1000;
+    const size_t bits = lag_us == 0 ? 0 : 64 - __builtin_clzl(lag_us);
+    const auto pos = std::min(bits, kBucketNum - 1);
+    GetBuckets()[pos].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Gather and clear recorded delays.
+   *
+   * @return The number of delays in each bucket.
+   */
+  static auto
+  Gather()  //
+      -> std::array<size_t, kBucketNum>
+  {
+    std::array<size_t, kBucketNum> counts{};
+    auto &buckets = GetBuckets();
+    for (size_t i = 0; i < kBucketNum; ++i) {
+      counts[i] = buckets[i].exchange(0, std::memory_order_relaxed);
+    }
+    return counts;
+  }
+
+  /**
+   * @return The current timestamp in nanoseconds.
+   */
+  static auto
+  GetTimestamp()  //
+      -> uint64_t
+  {
+    const auto &now = Clock_t::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+  }
+
+ private:
+  static auto
+  GetBuckets()  //
+      -> std::array<std::atomic_size_t, kBucketNum> &
+  {
+    static std::array<std::atomic_size_t, kBucketNum> buckets{};
+    return buckets;
+  }
+};
+
+/**
+ * @brief A page header for recording when a page is added to GC.
+ *
+ */
+struct Payload {
+  ~Payload()
+  {
+    if (added_at > 0) {
+      LagHistogram::Record(added_at);
+    }
+  }
+
+  uint64_t added_at{};
+};
+
+/*##############################################################################
+ * Target classes
+ *############################################################################*/
+
+struct EpochTarget : public DefaultTarget {
+  using T = Payload;
+};
+
+struct IntervalTarget : public DefaultTarget {
+  using T = Payload;
+  static constexpr bool kIntervalBased = true;
+};
+
+using EpochBasedGC_t = EpochBasedGC<EpochTarget, IntervalTarget>;
+
+/*##############################################################################
+ * Utilities for reporting results
+ *############################################################################*/
+
+/**
+ * @brief A struct for holding the usage of a pmemobj pool.
+ *
+ */
+struct PoolUsage {
+  /**
+   * @param path The path to a closed pmemobj pool.
+   * @return The number and total size of allocated objects in the pool.
+   */
+  static auto
+  Measure(                               //
+      const std::filesystem::path &path)  //
+      -> PoolUsage
+  {
+    PoolUsage usage{};
+    auto *pop = pmemobj_open(path.c_str(), kLayout);
+    if (pop == nullptr) return usage;
+
+    for (auto oid = pmemobj_first(pop); !OID_IS_NULL(oid); oid = pmemobj_next(oid)) {
+      ++usage.obj_num;
+      usage.bytes += pmemobj_alloc_usable_size(oid);
+    }
+    pmemobj_close(pop);
+    return usage;
+  }
+
+  /// @brief The number of allocated objects.
+  size_t obj_num{0};
+
+  /// @brief The total usable size of allocated objects.
+  size_t bytes{0};
+};
+
+/**
+ * @brief A struct for holding results of crash recovery.
+ *
+ */
+struct Result {
+  /**
+   * @brief Print results in a specified format.
+   *
+   */
+  void
+  Print() const
+  {
+    if (FLAGS_output_format == "json") {
+      const auto *interval_guard = FLAGS_interval_guard ? "true" : "false";
+      std::cout << "{\"crash_point\":\"" << FLAGS_crash_point << "\","          //
+                << "\"thread_num\":" << FLAGS_num_thread << ","                 //
+                << "\"garbage_num\":" << FLAGS_num_garbage << ","               //
+                << "\"ctor_time_us\":" << ctor_time_us << ","                   //
+                << "\"recovery_time_us\":" << recovery_time_us << ","           //
+                << "\"recovered_lists\":" << recovered_lists << ","             //
+                << "\"recovered_garbage\":" << recovered_garbage << ","         //
+                << "\"page_objs_before\":" << pages_before.obj_num << ","       //
+                << "\"page_bytes_before\":" << pages_before.bytes << ","        //
+                << "\"gc_objs_before\":" << gc_before.obj_num << ","            //
+                << "\"gc_bytes_before\":" << gc_before.bytes << ","             //
+                << "\"page_objs_after\":" << pages_after.obj_num << ","         //
+                << "\"page_bytes_after\":" << pages_after.bytes << ","          //
+                << "\"gc_objs_after\":" << gc_after.obj_num << ","              //
+                << "\"gc_bytes_after\":" << gc_after.bytes << ","               //
+                << "\"stall_time_us\":" << FLAGS_stall_time << ","              //
+                << "\"interval_guard\":" << interval_guard << ","               //
+                << "\"lag_histogram_us\":[";
+      for (size_t i = 0; i < kBucketNum; ++i) {
+        std::cout << (i == 0 ? "" : ",") << lags[i];
+      }
+      std::cout << "]}\n";
+      return;
+    }
+
+    std::cout << "crash_point,thread_num,garbage_num,ctor_time_us,recovery_time_us,"
+                 "recovered_lists,recovered_garbage,page_objs_before,page_bytes_before,"
+                 "gc_objs_before,gc_bytes_before,page_objs_after,page_bytes_after,"
+                 "gc_objs_after,gc_bytes_after\n";
+    std::cout << FLAGS_crash_point << ","      //
+              << FLAGS_num_thread << ","       //
+              << FLAGS_num_garbage << ","      //
+              << ctor_time_us << ","           //
+              << recovery_time_us << ","       //
+              << recovered_lists << ","        //
+              << recovered_garbage << ","      //
+              << pages_before.obj_num << ","   //
+              << pages_before.bytes << ","     //
+              << gc_before.obj_num << ","      //
+              << gc_before.bytes << ","        //
+              << pages_after.obj_num << ","    //
+              << pages_after.bytes << ","      //
+              << gc_after.obj_num << ","       //
+              << gc_after.bytes << "\n";
+    std::cout << "\nlag_lower_us,lag_upper_us,count\n";
+    for (size_t i = 0; i < kBucketNum; ++i) {
+      if (lags[i] == 0) continue;
+      const auto lower = i == 0 ? 0UL : 1UL << (i - 1);
+      std::cout << lower << "," << (i == kBucketNum - 1 ? "inf" : std::to_string(1UL << i)) << ","
+                << lags[i] << "\n";
+    }
+  }
+
+  /// @brief The elapsed time of the constructor of GC.
+  uint64_t ctor_time_us{0};
+
+  /// @brief The elapsed time of releasing left garbage lists.
+  uint64_t recovery_time_us{0};
+
+  /// @brief The number of recovered garbage lists.
+  size_t recovered_lists{0};
+
+  /// @brief The number of garbage released by recovery.
+  size_t recovered_garbage{0};
+
+  /// @brief The usage of the pool for pages after a crash.
+  PoolUsage pages_before{};
+
+  /// @brief The usage of the pool for GC after a crash.
+  PoolUsage gc_before{};
+
+  /// @brief The usage of the pool for pages after recovery.
+  PoolUsage pages_after{};
+
+  /// @brief The usage of the pool for GC after recovery.
+  PoolUsage gc_after{};
+
+  /// @brief A histogram of delays between AddGarbage and reclamation.
+  std::array<size_t, kBucketNum> lags{};
+};
+
+/*##############################################################################
+ * Benchmark procedures
+ *############################################################################*/
+
+/**
+ * @brief A class for measuring crash recovery and reclamation lag.
+ *
+ */
+class Bench
+{
+ public:
+  /**
+   * @brief Construct a new Bench object.
+   *
+   * @param pmem_dir The path to a working directory on persistent memory.
+   */
+  explicit Bench(const std::filesystem::path &pmem_dir)
+  {
+    pool_path_ = pmem_dir / kPoolName;
+    gc_path_ = pmem_dir / kGCName;
+    std::filesystem::remove(pool_path_);
+    std::filesystem::remove(gc_path_);
+
+    // a child process opens the pool again after fork
+    auto *pop = pmemobj_create(pool_path_.c_str(), kLayout, FLAGS_pool_size, kModeRW);
+    if (pop == nullptr) {
+      throw std::runtime_error{pmemobj_errormsg()};
+    }
+    pmemobj_close(pop);
+  }
+
+  Bench(const Bench &) = delete;
+  Bench(Bench &&) = delete;
+
+  auto operator=(const Bench &) -> Bench & = delete;
+  auto operator=(Bench &&) -> Bench & = delete;
+
+  ~Bench()
+  {
+    std::filesystem::remove(pool_path_);
+    std::filesystem::remove(gc_path_);
+  }
+
+  /**
+   * @brief Kill a child process that adds garbage and measure its recovery.
+   *
+   * @return Measured results.
+   */
+  auto
+  Run()  //
+      -> Result
+  {
+    Result res{};
+    Crash();
+    res.pages_before = PoolUsage::Measure(pool_path_);
+    res.gc_before = PoolUsage::Measure(gc_path_);
+
+    // measure the constructor that releases the left garbage lists
+    pop_ = pmemobj_open(pool_path_.c_str(), kLayout);
+    if (pop_ == nullptr) {
+      throw std::runtime_error{pmemobj_errormsg()};
+    }
+    const auto start = Clock_t::now();
+    auto gc = std::make_unique<EpochBasedGC_t>(gc_path_, FLAGS_gc_size, kLayout, FLAGS_gc_interval,
+                                               FLAGS_gc_thread, 0, FLAGS_recover_in_background);
+    const auto end = Clock_t::now();
+    res.ctor_time_us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    const auto &info = gc->GetRecoveryInfo();
+    res.recovery_time_us = info.time.count();
+    res.recovered_lists = info.list_num;
+    res.recovered_garbage = info.garbage_num;
+
+    // measure reclamation lag under a stalled reader
+    gc->StartGC();
+    if (FLAGS_interval_guard) {
+      res.lags = MeasureLag<IntervalTarget>(gc.get());
+    } else {
+      res.lags = MeasureLag<EpochTarget>(gc.get());
+    }
+    gc.reset(nullptr);
+    pmemobj_close(pop_);
+    pop_ = nullptr;
+
+    res.pages_after = PoolUsage::Measure(pool_path_);
+    res.gc_after = PoolUsage::Measure(gc_path_);
+    return res;
+  }
+
+ private:
+  /**
+   * @brief Fork a child process that fills thread-local slots and kill it.
+   *
+   * If `crash_point` is `add`, the child is killed while workers keep adding
+   * garbage without GC. If `crash_point` is `clear`, cleaner threads also
+   * release and swap the heads of garbage lists when the child is killed.
+   */
+  void
+  Crash()
+  {
+    int fds[2];
+    if (pipe(fds) != 0) {
+      throw std::runtime_error{"failed to create a pipe."};
+    }
+
+    const auto pid = fork();
+    if (pid < 0) {
+      throw std::runtime_error{"failed to fork a process."};
+    }
+    if (pid == 0) {
+      close(fds[0]);
+      RunVictim(fds[1]);
+      _exit(0);
+    }
+
+    // wait until all the slots are filled, and kill the child in the middle of work
+    close(fds[1]);
+    char buf{};
+    const auto filled = read(fds[0], &buf, 1) == 1;
+    close(fds[0]);
+    if (filled) {
+      std::this_thread::sleep_for(std::chrono::microseconds{FLAGS_kill_delay});
+    }
+    kill(pid, SIGKILL);
+    waitpid(pid, nullptr, 0);
+    if (!filled) {
+      throw std::runtime_error{"a child process exited before filling slots."};
+    }
+  }
+
+  /**
+   * @brief A procedure of a child process to be killed.
+   *
+   * @param fd A pipe to notify that all the workers have added `num_garbage`.
+   */
+  void
+  RunVictim(const int fd)
+  {
+    pop_ = pmemobj_open(pool_path_.c_str(), kLayout);
+    if (pop_ == nullptr) return;
+
+    // the instance is intentionally leaked because the process is killed
+    auto *gc = new EpochBasedGC_t{gc_path_, FLAGS_gc_size, kLayout, FLAGS_gc_interval,
+                                  FLAGS_gc_thread};
+    if (FLAGS_crash_point == "clear") {
+      gc->StartGC();
+    }
+
+    std::atomic_size_t filled{0};
+    for (size_t i = 0; i < FLAGS_num_thread; ++i) {
+      std::thread{[&]() {
+        // keep adding garbage until SIGKILL (bounded so as not to exhaust the pool)
+        auto *tmp_oid = gc->GetTmpField<EpochTarget>(0);
+        for (size_t j = 0; j < FLAGS_num_garbage * 2; ++j) {
+          Malloc(pop_, tmp_oid, FLAGS_page_size);
+          new (pmemobj_direct(*tmp_oid)) Payload{};
+          gc->AddGarbage<EpochTarget>(tmp_oid);
+          if (j + 1 == FLAGS_num_garbage) {
+            filled.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      }}.detach();
+    }
+    while (filled.load(std::memory_order_relaxed) < FLAGS_num_thread) {
+      std::this_thread::sleep_for(std::chrono::microseconds{100});
+    }
+    const char buf = 0;
+    [[maybe_unused]] const auto written = write(fd, &buf, 1);
+    while (true) {
+      std::this_thread::sleep_for(std::chrono::seconds{1});  // wait for SIGKILL
+    }
+  }
+
+  /**
+   * @brief Measure delays between AddGarbage and reclamation.
+   *
+   * If `stall_time` is positive, a reader thread repeats holding a guard for the
+   * duration while worker threads add garbage.
+   *
+   * @tparam Target A target class of garbage collection.
+   * @param gc A garbage collector.
+   * @return A histogram of measured delays.
+   */
+  template <class Target>
+  auto
+  MeasureLag(EpochBasedGC_t *gc)  //
+      -> std::array<size_t, kBucketNum>
+  {
+    std::atomic_bool is_running{true};
+    std::thread reader{};
+    if (FLAGS_stall_time > 0) {
+      reader = std::thread{[&]() {
+        while (is_running.load(std::memory_order_relaxed)) {
+          if constexpr (Target::kIntervalBased) {
+            const auto &guard = gc->CreateIntervalGuard();
+            guard.Read([]() { return 0; });
+            std::this_thread::sleep_for(std::chrono::microseconds{FLAGS_stall_time});
+          } else {
+            const auto &guard = gc->CreateEpochGuard();
+            std::this_thread::sleep_for(std::chrono::microseconds{FLAGS_stall_time});
+          }
+        }
+      }};
+    }
+
+    std::vector<std::thread> workers{};
+    for (size_t i = 0; i < FLAGS_num_thread; ++i) {
+      workers.emplace_back([&]() {
+        auto *tmp_oid = gc->GetTmpField<Target>(0);
+        for (size_t j = 0; j < FLAGS_num_exec; ++j) {
+          const auto birth = gc->GetCurrentEpoch();
+          Malloc(pop_, tmp_oid, FLAGS_page_size);
+          auto *page = new (pmemobj_direct(*tmp_oid)) Payload{};
+          page->added_at = LagHistogram::GetTimestamp();
+          if constexpr (Target::kIntervalBased) {
+            gc->AddGarbage<Target>(tmp_oid, birth);
+          } else {
+            gc->AddGarbage<Target>(tmp_oid);
+          }
+        }
+      });
+    }
+    for (auto &&t : workers) {
+      t.join();
+    }
+    is_running.store(false, std::memory_order_relaxed);
+    if (reader.joinable()) {
+      reader.join();
+    }
+
+    // wait for GC to reclaim the remaining garbage
+    gc->StopGC();
+    return LagHistogram::Gather();
+  }
+
+  /// @brief The path to a pmemobj pool for pages.
+  std::filesystem::path pool_path_{};
+
+  /// @brief The path to a pmemobj pool for GC.
+  std::filesystem::path gc_path_{};
+
+  /// @brief A pmemobj pool for pages.
+  PMEMobjpool *pop_{nullptr};
+};
+
+}  // namespace dbgroup::pmem::memory::bench
+
+/*##############################################################################
+ * Main function
+ *############################################################################*/
+
+auto
+main(  //
+    int argc,
+    char *argv[])  //
+    -> int
+{
+  using ::dbgroup::pmem::memory::bench::Bench;
+
+  gflags::SetUsageMessage("measures crash recovery and reclamation lag of EpochBasedGC.");
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  if (FLAGS_pmem_dir.empty() || !std::filesystem::exists(FLAGS_pmem_dir)) {
+    std::cerr << "A valid path to persistent memory must be specified." << std::endl;
+    return 1;
+  }
+
+  Bench bench{FLAGS_pmem_dir};
+  bench.Run().Print();
+
+  return 0;
+}
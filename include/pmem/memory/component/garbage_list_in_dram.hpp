@@ -18,9 +18,12 @@
 #define PMEM_MEMORY_COMPONENT_GARBAGE_LIST_IN_DRAM_HPP
 
 // C++ standard libraries
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <memory>
 #include <type_traits>
 
 // external system libraries
@@ -28,6 +31,10 @@
 
 // local sources
 #include "pmem/memory/component/garbage_list_in_pmem.hpp"
+#include "pmem/memory/component/list_stats.hpp"
+#include "pmem/memory/component/reserved_intervals.hpp"
+#include "pmem/memory/component/shared_page_pool.hpp"
+#include "pmem/memory/component/tls_fields.hpp"
 #include "pmem/memory/utility.hpp"
 
 namespace dbgroup::pmem::memory::component
@@ -39,6 +46,27 @@ namespace dbgroup::pmem::memory::component
 class alignas(kCacheLineSize) GarbageListInDRAM
 {
  public:
+  /*############################################################################
+   * Public classes
+   *##########################################################################*/
+
+  /**
+   * @brief Volatile information for recycling drained lists.
+   *
+   * @note Cleaner threads and client threads modify this instance with the
+   * lock of the corresponding list header.
+   */
+  struct Recycler {
+    /// @brief Persistent stacks of spare lists.
+    SpareLists *lists{nullptr};
+
+    /// @brief The number of lists in `lists->returned`.
+    std::atomic_size_t returned_num{0};
+
+    /// @brief The maximum number of lists in `lists->returned`.
+    size_t capacity{0};
+  };
+
   /*############################################################################
    * Public constructors and assignment operators
    *##########################################################################*/
@@ -63,7 +91,7 @@ class alignas(kCacheLineSize) GarbageListInDRAM
    * @brief Destroy the instance.
    *
    */
-  ~GarbageListInDRAM() = default;
+  ~GarbageListInDRAM();
 
   /*############################################################################
    * Public getters/setters
@@ -76,10 +104,27 @@ class alignas(kCacheLineSize) GarbageListInDRAM
   [[nodiscard]] auto Empty() const  //
       -> bool;
 
+  /**
+   * @brief Record the birth epoch of garbage that will be added next.
+   *
+   * @param birth An epoch when the garbage was allocated.
+   * @note This function must be called by the owner thread before adding the
+   * garbage.
+   */
+  void SetBirth(  //
+      size_t birth);
+
   /*############################################################################
    * Public utility functions
    *##########################################################################*/
 
+  /**
+   * @brief Reset this list for reusing it with a recycled persistent list.
+   *
+   * @note This function must be called only if no thread refers to this list.
+   */
+  void Reset();
+
   /**
    * @brief Add a new garbage instance to the list tail.
    *
@@ -87,6 +132,8 @@ class alignas(kCacheLineSize) GarbageListInDRAM
    * @param[in] epoch An epoch in which garbage was added.
    * @param[in,out] garbage A new garbage instance.
    * @param[in] pop A pmemobj_pool instance for allocation.
+   * @param[in,out] stats Statistics counters of a client thread.
+   * @param[in,out] spare_addr The address of a stack of spare lists if exist.
    * @note If the list becomes full, this function creates a new list and link
    * them.
    * @note After adding garbage to the list, a given PMEMoid pointer will be
@@ -96,7 +143,32 @@ class alignas(kCacheLineSize) GarbageListInDRAM
       GarbageListInPMEM **list_addr,
       size_t epoch,
       PMEMoid *garbage,
-      PMEMobjpool *pop);
+      PMEMobjpool *pop,
+      ListStats *stats,
+      PMEMoid *spare_addr = nullptr);
+
+  /**
+   * @brief Add new garbage instances to the list tail.
+   *
+   * @param[in,out] list_addr The address of the pointer of a target list.
+   * @param[in] epoch An epoch in which garbage was added.
+   * @param[in,out] garbages New garbage instances.
+   * @param[in] n The number of garbage instances.
+   * @param[in] pop A pmemobj_pool instance for allocation.
+   * @param[in,out] stats Statistics counters of a client thread.
+   * @param[in,out] spare_addr The address of a stack of spare lists if exist.
+   * @note If the list becomes full, this function creates a new list and link
+   * them.
+   * @note After adding garbage to the list, given PMEMoids will be NULL.
+   */
+  static void AddGarbages(  //
+      GarbageListInPMEM **list_addr,
+      size_t epoch,
+      PMEMoid *garbages,
+      size_t n,
+      PMEMobjpool *pop,
+      ListStats *stats,
+      PMEMoid *spare_addr = nullptr);
 
   /**
    * @brief Reuse a destructed page.
@@ -114,30 +186,53 @@ class alignas(kCacheLineSize) GarbageListInDRAM
    * @param[in,out] list_oid The address of a target PMEMoid.
    * @param[in] protected_epoch A protected epoch.
    * @param[in] tmp_oid Thread local fields.
+   * @param[in,out] stats Statistics counters of a cleaner thread.
+   * @param[in,out] recycler Stacks to return drained lists if exist.
+   * @param[in] shared_pool A pool to donate surplus destructed pages if exist.
+   * @param[in] max_num The maximum number of garbage to be destructed or
+   * released in this call.
+   * @tparam T A class that has a target destruction procedure.
+   * @tparam kReleaseInBatch A flag for releasing a list by one action batch.
+   * @tparam kPrefetch The number of pages prefetched ahead of destruction.
+   * @retval true if the list still has garbage to be destructed.
+   * @retval false otherwise.
    */
-  template <class T>
-  static void
+  template <class T, bool kReleaseInBatch = false, size_t kPrefetch = 0>
+  static auto
   Destruct(  //
       PMEMoid *list_oid,
       const size_t protected_epoch,
-      PMEMoid *tmp_oid)
+      PMEMoid *tmp_oid,
+      ListStats *stats,
+      Recycler *recycler,
+      SharedPagePool *shared_pool = nullptr,
+      size_t max_num = std::numeric_limits<size_t>::max())  //
+      -> bool
   {
     GarbageListInDRAM *reuse_head = nullptr;
 
     while (true) {
+      if (max_num == 0) return true;
       auto *pmem = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*list_oid));
       auto *dram = pmem->dram;
 
       // destruct obsolete garbage
       const auto end_pos = dram->end_pos_.load(kAcquire);
-      auto mid_pos = dram->mid_pos_.load(kRelaxed);
-      for (; mid_pos < end_pos && dram->epochs_[mid_pos] < protected_epoch; ++mid_pos) {
-        if constexpr (!std::is_same_v<T, void>) {
-          pmem->template DestructGarbage<T>(mid_pos);
+      const auto begin_mid = dram->mid_pos_.load(kRelaxed);
+      const auto mid_pos =
+          std::min(FindProtectedPos(dram->epochs_, begin_mid, end_pos, protected_epoch),
+                   begin_mid + std::min(max_num, kBufferSize));
+      if constexpr (!std::is_same_v<T, void>) {
+        PrefetchFirst<T, kPrefetch>(pmem, begin_mid, mid_pos);
+        for (auto i = begin_mid; i < mid_pos; ++i) {
+          PrefetchNext<kPrefetch>(pmem, i, mid_pos);
+          pmem->template DestructGarbage<T>(i);
         }
       }
       dram->mid_pos_.store(mid_pos, kRelease);
-      if (mid_pos < kBufferSize) break;
+      ListStats::Add(stats->destructed, mid_pos - begin_mid);
+      max_num -= mid_pos - begin_mid;
+      if (mid_pos < kBufferSize) return mid_pos < end_pos;
 
       // check the list can be released
       auto pos = dram->begin_pos_.load(kAcquire);
@@ -147,8 +242,7 @@ class alignas(kCacheLineSize) GarbageListInDRAM
           list_oid = &(pmem->next);
           tmp_oid = &(pmem->tmp);
         } else {
-          GarbageListInPMEM::ExchangeHead(pmem, list_oid, tmp_oid);
-          delete dram;
+          RemoveHead(pmem, list_oid, tmp_oid, stats, recycler);
         }
         continue;
       }
@@ -159,11 +253,22 @@ class alignas(kCacheLineSize) GarbageListInDRAM
         const auto next = dram->next_.load(kRelaxed);
         if ((cur & kUsed) == 0
             && reuse_head->next_.compare_exchange_strong(cur, next, kRelease, kRelaxed)) {
-          for (; pos < kBufferSize; ++pos) {
-            pmem->ReleaseGarbage(pos);
+          if (shared_pool != nullptr && shared_pool->Donate(list_oid)) {
+            delete dram;
+            ListStats::Add(stats->removed_lists);
+            continue;
+          }
+          if constexpr (kReleaseInBatch) {
+            pmem->ReleaseGarbages(pos, kBufferSize);
+          } else {
+            for (size_t i = pos; i < kBufferSize; ++i) {
+              pmem->ReleaseGarbage(i);
+            }
           }
-          GarbageListInPMEM::ExchangeHead(pmem, list_oid, tmp_oid);
-          delete dram;
+          ListStats::Add(stats->released, kBufferSize - pos);
+          ListStats::Add(stats->free_num, kBufferSize - pos);
+          max_num -= std::min(max_num, kBufferSize - pos);
+          RemoveHead(pmem, list_oid, tmp_oid, stats, recycler);
           continue;
         }
       }
@@ -179,36 +284,102 @@ class alignas(kCacheLineSize) GarbageListInDRAM
    * @param[in,out] list_oid The address of a target PMEMoid.
    * @param[in] protected_epoch A protected epoch.
    * @param[in] tmp_oid Thread local fields.
+   * @param[in,out] stats Statistics counters of a cleaner thread.
+   * @param[in,out] recycler Stacks to return drained lists if exist.
+   * @param[in] max_num The maximum number of garbage to be released in this
+   * call.
+   * @tparam T A class that has a target destruction procedure.
+   * @tparam kReleaseInBatch A flag for releasing garbage by one action batch.
+   * @tparam kPrefetch The number of pages prefetched ahead of destruction.
+   * @retval true if the list still has garbage to be released.
+   * @retval false otherwise.
    */
-  template <class T>
-  static void
+  template <class T, bool kReleaseInBatch = false, size_t kPrefetch = 0>
+  static auto
   Clear(  //
       PMEMoid *list_oid,
       const size_t protected_epoch,
-      PMEMoid *tmp_oid)
+      PMEMoid *tmp_oid,
+      ListStats *stats,
+      Recycler *recycler = nullptr,
+      size_t max_num = std::numeric_limits<size_t>::max())  //
+      -> bool
   {
     while (true) {
+      if (max_num == 0) return true;
       auto *pmem = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*list_oid));
       auto *dram = pmem->dram;
 
-      const auto mid_pos = dram->mid_pos_.load(kRelaxed);
-      auto pos = dram->begin_pos_.load(kRelaxed);
-      for (; pos < mid_pos; ++pos) {
-        pmem->ReleaseGarbage(pos);
-      }
+      const auto begin_mid = dram->mid_pos_.load(kRelaxed);
+      const auto begin_pos = dram->begin_pos_.load(kRelaxed);
       const auto end_pos = dram->end_pos_.load(kAcquire);
-      for (; pos < end_pos && dram->epochs_[pos] < protected_epoch; ++pos) {
-        if constexpr (!std::is_same_v<T, void>) {
-          pmem->template DestructGarbage<T>(pos);
+      const auto pos =
+          std::min(FindProtectedPos(dram->epochs_, begin_mid, end_pos, protected_epoch),
+                   begin_pos + std::min(max_num, kBufferSize));
+      const auto mid_pos = std::min(begin_mid, pos);  // a budget may end before destructed ones
+      if constexpr (!std::is_same_v<T, void>) {
+        PrefetchFirst<T, kPrefetch>(pmem, mid_pos, pos);
+        for (auto i = mid_pos; i < pos; ++i) {
+          PrefetchNext<kPrefetch>(pmem, i, pos);
+          pmem->template DestructGarbage<T>(i);
+        }
+      }
+      if constexpr (kReleaseInBatch) {
+        pmem->ReleaseGarbages(begin_pos, pos);
+      } else {
+        for (auto i = begin_pos; i < pos; ++i) {
+          pmem->ReleaseGarbage(i);
         }
-        pmem->ReleaseGarbage(pos);
       }
       dram->begin_pos_.store(pos, kRelaxed);
-      dram->mid_pos_.store(pos, kRelaxed);
-      if (pos < kBufferSize) break;
+      dram->mid_pos_.store(std::max(begin_mid, pos), kRelaxed);
+      ListStats::Add(stats->destructed, pos - mid_pos);
+      ListStats::Add(stats->released, pos - begin_pos);
+      ListStats::Add(stats->free_num, pos - begin_pos);
+      max_num -= pos - begin_pos;
+      if (pos < kBufferSize) return pos < end_pos;
+
+      RemoveHead(pmem, list_oid, tmp_oid, stats, recycler);
+    }
+  }
 
-      pmem = GarbageListInPMEM::ExchangeHead(pmem, list_oid, tmp_oid);
-      delete dram;
+  /**
+   * @brief Release garbage whose lifetime does not overlap any reserved interval.
+   *
+   * Unlike `Clear`, this function checks garbage out of order, and so it can
+   * release garbage retired after the epoch of a stalled interval guard. The
+   * released slots become NULL and are skipped by the following `Clear`,
+   * which also counts them in statistics.
+   *
+   * @tparam T A class that has a target destruction procedure.
+   * @param[in] list_oid The address of the head of target lists.
+   * @param[in] intervals A snapshot of reserved epochs.
+   * @note This function must be called with the lock of the list header.
+   */
+  template <class T>
+  static void
+  ClearByIntervals(  //
+      const PMEMoid *list_oid,
+      const ReservedIntervals &intervals)
+  {
+    auto *pmem = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*list_oid));
+    for (; pmem != nullptr; pmem = pmem->GetNext()) {
+      auto *dram = pmem->dram;
+      const auto end_pos = dram->end_pos_.load(kAcquire);
+      const auto *births = dram->births_.load(kAcquire);
+      if (births != nullptr) {
+        for (auto pos = dram->begin_pos_.load(kRelaxed); pos < end_pos; ++pos) {
+          if (!intervals.CanRelease(births[pos], dram->epochs_[pos])
+              || !pmem->HasGarbage(pos)) {
+            continue;
+          }
+          if constexpr (!std::is_same_v<T, void>) {
+            pmem->template DestructGarbage<T>(pos);
+          }
+          pmem->ReleaseGarbage(pos);
+        }
+      }
+      if (end_pos < kBufferSize) break;
     }
   }
 
@@ -223,6 +394,114 @@ class alignas(kCacheLineSize) GarbageListInDRAM
    * Internal utilities
    *##########################################################################*/
 
+  /**
+   * @brief Find the first garbage protected by a given epoch.
+   *
+   * @param epochs Epochs when each garbage was registered.
+   * @param pos The position of the first garbage to be checked.
+   * @param end_pos The position next to the last garbage in the list.
+   * @param protected_epoch A protected epoch.
+   * @return The position of the first protected garbage (`end_pos` if all the
+   * garbage can be reclaimed).
+   * @note Only the owner thread appends garbage with the current global epoch,
+   * and so the epochs in each list are monotonically non-decreasing.
+   */
+  static auto
+  FindProtectedPos(  //
+      const size_t *epochs,
+      const size_t pos,
+      const size_t end_pos,
+      const size_t protected_epoch)  //
+      -> size_t
+  {
+    if (pos >= end_pos || epochs[end_pos - 1] < protected_epoch) return end_pos;
+    return std::lower_bound(&(epochs[pos]), &(epochs[end_pos - 1]), protected_epoch) - epochs;
+  }
+
+  /**
+   * @brief Prefetch the pages of the first garbage to be destructed.
+   *
+   * @tparam T A class that has a target destruction procedure.
+   * @tparam kPrefetch The number of pages prefetched ahead of destruction.
+   * @param pmem A target list.
+   * @param pos The position of the first garbage to be destructed.
+   * @param end_pos The position next to the last garbage in the list.
+   */
+  template <class T, size_t kPrefetch>
+  static void
+  PrefetchFirst(  //
+      [[maybe_unused]] const GarbageListInPMEM *pmem,
+      [[maybe_unused]] const size_t pos,
+      [[maybe_unused]] const size_t end_pos)
+  {
+    if constexpr (kPrefetch > 0 && !std::is_same_v<T, void>) {
+      const auto end = std::min(pos + kPrefetch, end_pos);
+      for (auto i = pos; i < end; ++i) {
+        pmem->PrefetchGarbage(i);
+      }
+    }
+  }
+
+  /**
+   * @brief Prefetch the page of garbage `kPrefetch` slots ahead of a given one.
+   *
+   * @tparam kPrefetch The number of pages prefetched ahead of destruction.
+   * @param pmem A target list.
+   * @param pos The position of garbage to be destructed now.
+   * @param end_pos The position next to the last garbage in the list.
+   */
+  template <size_t kPrefetch>
+  static void
+  PrefetchNext(  //
+      [[maybe_unused]] const GarbageListInPMEM *pmem,
+      [[maybe_unused]] const size_t pos,
+      [[maybe_unused]] const size_t end_pos)
+  {
+    if constexpr (kPrefetch > 0) {
+      if (pos + kPrefetch < end_pos) {
+        pmem->PrefetchGarbage(pos + kPrefetch);
+      }
+    }
+  }
+
+  /**
+   * @brief Remove a drained list from the head of garbage lists.
+   *
+   * @param[in] pmem The drained list.
+   * @param[in,out] list_oid The address of a PMEMoid that refers to the list.
+   * @param[in] tmp_oid A temporary field for swapping.
+   * @param[in,out] stats Statistics counters of a cleaner thread.
+   * @param[in,out] recycler Stacks to return drained lists if exist.
+   * @note If the stack of returned lists has free space, the list is moved to
+   * the stack instead of being released. In this case, the companion list in
+   * DRAM is also kept for recycling.
+   */
+  static void
+  RemoveHead(  //
+      GarbageListInPMEM *pmem,
+      PMEMoid *list_oid,
+      PMEMoid *tmp_oid,
+      ListStats *stats,
+      Recycler *recycler)
+  {
+    auto *dram = pmem->dram;
+    ListStats::Add(stats->removed_lists);
+    if (recycler != nullptr) {
+      const auto num = recycler->returned_num.load(kRelaxed);
+      if (num < recycler->capacity
+          && GarbageListInPMEM::PushList(list_oid, &(recycler->lists->returned))) {
+        recycler->returned_num.store(num + 1, kRelaxed);
+        dram->Reset();
+        return;
+      }
+    }
+
+    GarbageListInPMEM::ExchangeHead(pmem, list_oid, tmp_oid);
+    delete dram;
+    ListStats::Add(stats->persist_num);
+    ListStats::Add(stats->free_num);
+  }
+
   /**
    * @brief Release a given garbage list and swap to the next list.
    *
@@ -251,6 +530,10 @@ class alignas(kCacheLineSize) GarbageListInDRAM
   /// @brief The position of the last garbage.
   std::atomic_size_t end_pos_{0};
 
+  /// @brief Epochs when each garbage was allocated (only for interval-based
+  /// targets). The owner thread allocates them and cleaners read them.
+  std::atomic<size_t *> births_{nullptr};
+
   /// @brief The next garbage list address for client threads.
   std::atomic_uintptr_t next_{};
 };
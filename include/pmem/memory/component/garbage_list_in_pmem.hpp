@@ -20,6 +20,7 @@
 // C++ standard libraries
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 // external system libraries
 #include <libpmemobj.h>
@@ -88,10 +89,130 @@ class GarbageListInPMEM
    * @brief Release all garbage for recovery.
    *
    * @param tls The pointer to thread-local fields.
+   * @return The number of released garbage.
    * @note This function does not perform any destruction for garbage.
    */
-  static void ReleaseAllGarbages(  //
-      TLSFields *tls);
+  static auto ReleaseAllGarbages(  //
+      TLSFields *tls)              //
+      -> size_t;
+
+  /**
+   * @brief Release all garbage in additional lists of a thread for recovery.
+   *
+   * @param head The head pointer of target garbage lists.
+   * @param tmp_head A temporary field to swap head pointers.
+   * @param tls The pointer to thread-local fields that have temporary fields.
+   * @return The number of released garbage.
+   * @note This function does not perform any destruction for garbage.
+   */
+  static auto ReleaseAllGarbages(  //
+      PMEMoid *head,
+      PMEMoid *tmp_head,
+      TLSFields *tls)  //
+      -> size_t;
+
+  /**
+   * @brief Release all garbage for recovery except for PMEMoids in the
+   * temporary fields of other threads.
+   *
+   * @param tls The pointer to thread-local fields of a target list.
+   * @param others Thread-local fields that may have PMEMoids reused from the
+   * target list.
+   * @return The number of released garbage.
+   * @note This function is used for lists shared by multiple threads.
+   */
+  static auto ReleaseAllGarbages(  //
+      TLSFields *tls,
+      const std::vector<const TLSFields *> &others)  //
+      -> size_t;
+
+  /**
+   * @brief Move all the garbage lists of a thread to another fields for
+   * releasing them in the background.
+   *
+   * @param head The head pointer of target garbage lists.
+   * @param tmp_head A temporary field to swap head pointers.
+   * @param tls The pointer to thread-local fields that have temporary fields.
+   * @param dest Empty fields to hold the lists and copies of temporary fields.
+   * @retval true if the lists are moved and `head` becomes NULL.
+   * @retval false if PMDK failed to publish the modification.
+   * @note After this function succeeds, `ReleaseAllGarbages(dest)` releases
+   * the lists without referring to the temporary fields in `tls`.
+   */
+  static auto DetachAllGarbages(  //
+      PMEMoid *head,
+      PMEMoid *tmp_head,
+      const TLSFields *tls,
+      TLSFields *dest)  //
+      -> bool;
+
+  /**
+   * @brief Move a list to another position atomically.
+   *
+   * @param src_addr The address of a PMEMoid that refers to a target list.
+   * @param dest_addr The address of a NULL PMEMoid to refer to the list.
+   * @retval true if the list is moved and `src_addr` refers to its next list.
+   * @retval false if PMDK failed to publish the modification.
+   * @note All the PMEMoids and the list must be in the same pool.
+   */
+  static auto MoveList(    //
+      PMEMoid *src_addr,
+      PMEMoid *dest_addr)  //
+      -> bool;
+
+  /**
+   * @brief Move a list to the top of a stack of lists atomically.
+   *
+   * @param src_addr The address of a PMEMoid that refers to a target list.
+   * @param stack_addr The address of a PMEMoid that refers to the top of a
+   * stack (NULL if the stack is empty).
+   * @retval true if the list is moved and `src_addr` refers to its next list.
+   * @retval false if PMDK failed to publish the modification.
+   * @note All the PMEMoids and the list must be in the same pool.
+   */
+  static auto PushList(     //
+      PMEMoid *src_addr,
+      PMEMoid *stack_addr)  //
+      -> bool;
+
+  /**
+   * @brief Move all the lists linked from a PMEMoid to another one atomically.
+   *
+   * @param src_addr The address of a PMEMoid that refers to target lists.
+   * @param dest_addr The address of a NULL PMEMoid to refer to the lists.
+   * @retval true if the lists are moved and `src_addr` becomes NULL.
+   * @retval false if PMDK failed to publish the modification.
+   * @note All the PMEMoids and the lists must be in the same pool.
+   */
+  static auto MoveAllLists(  //
+      PMEMoid *src_addr,
+      PMEMoid *dest_addr)  //
+      -> bool;
+
+  /**
+   * @brief Release lists that do not have any garbage.
+   *
+   * @param head_addr The address of a PMEMoid that refers to target lists.
+   * @note Each list is released and unlinked by a single action batch, so this
+   * function can be resumed after machine failures. If PMDK fails to publish
+   * an action batch, the remaining lists are kept in `head_addr`.
+   */
+  static void ReleaseEmptyLists(  //
+      PMEMoid *head_addr);
+
+  /**
+   * @brief Allocate a new empty list.
+   *
+   * @param pop A pmemobj_pool instance for allocation.
+   * @param list_addr The address of a NULL PMEMoid to refer to a new list.
+   * @param compact A flag for storing only the offsets of garbage.
+   * @note A compact list is about half the size of a normal one, and it is
+   * marked as compact before being linked to `list_addr`.
+   */
+  static void CreateList(  //
+      PMEMobjpool *pop,
+      PMEMoid *list_addr,
+      bool compact);
 
   /*############################################################################
    * Public utilities
@@ -102,6 +223,8 @@ class GarbageListInPMEM
    *
    * @param[in] pos The position to be added.
    * @param[in,out] garbage A PMEMoid to be reclainmed.
+   * @throws std::runtime_error if this list is compact and the PMEMoid is in
+   * another pool than the previous garbage (the PMEMoid is not modified).
    * @note When this function successfully completes its process, the specified
    * PMEMoid becomes NULL.
    */
@@ -109,6 +232,24 @@ class GarbageListInPMEM
       size_t pos,
       PMEMoid *garbage);
 
+  /**
+   * @brief Add given garbage PMEMoids to consecutive positions of this list.
+   *
+   * @param[in] pos The first position to be added.
+   * @param[in,out] garbages PMEMoids to be reclainmed.
+   * @param[in] n The number of PMEMoids.
+   * @throws std::runtime_error if this list is compact and any PMEMoid is in
+   * another pool than the previous garbage (the PMEMoids are not modified).
+   * @note This function flushes the consecutive positions at once and drains
+   * only once before nullifying the given PMEMoids.
+   * @note When this function successfully completes its process, the specified
+   * PMEMoids become NULL.
+   */
+  void AddGarbages(  //
+      size_t pos,
+      PMEMoid *garbages,
+      size_t n);
+
   /**
    * @brief Reuse PMEMoid.
    *
@@ -127,6 +268,21 @@ class GarbageListInPMEM
   void ReleaseGarbage(  //
       size_t pos);
 
+  /**
+   * @brief Release target PMEMoids with a small number of redo-log commits.
+   *
+   * @param begin_pos The position of the first PMEMoid to be released.
+   * @param end_pos The position next to the last PMEMoid to be released.
+   * @note Consecutive PMEMoids in the same pool are released by one action
+   * batch. If they are in the same pool as this list, the batch also clears
+   * their slots atomically. Otherwise, this function clears the slots before
+   * publishing the batch, and so a machine failure between them may leak the
+   * PMEMoids of the batch instead of freeing them doubly.
+   */
+  void ReleaseGarbages(  //
+      size_t begin_pos,
+      size_t end_pos);
+
   /**
    * @return The next garbage list.
    */
@@ -137,10 +293,14 @@ class GarbageListInPMEM
    * @brief Create the next garbage list and link to this.
    *
    * @param pop A pmemobj_pool instance for allocation.
+   * @param spare_addr The address of a stack of spare lists if exist.
    * @return The next garbage list.
+   * @note If there is a spare list, this function reuses it instead of
+   * allocating a new one. A new list has the same layout as this list.
    */
-  auto CreateNextList(   //
-      PMEMobjpool *pop)  //
+  auto CreateNextList(  //
+      PMEMobjpool *pop,
+      PMEMoid *spare_addr = nullptr)  //
       -> GarbageListInPMEM *;
 
   /**
@@ -149,24 +309,52 @@ class GarbageListInPMEM
    * @tparam T A class that has a target destruction procedure.
    * @param pos The position of PMEMoid to be destructed.
    * @note This function only performs destruction and does not free garbage.
+   * @note An already released (i.e., NULL) slot is skipped.
    */
   template <class T>
   void
   DestructGarbage(  //
       const size_t pos)
   {
-    auto *ptr = reinterpret_cast<T *>(pmemobj_direct(garbages_[pos]));
+    auto *ptr = reinterpret_cast<T *>(pmemobj_direct(GetGarbage(pos)));
+    if (ptr == nullptr) return;
     ptr->~T();
   }
 
+  /**
+   * @brief Prefetch the page of a target PMEMoid into CPU caches.
+   *
+   * @param pos The position of PMEMoid to be destructed soon.
+   */
+  void
+  PrefetchGarbage(  //
+      const size_t pos) const
+  {
+    __builtin_prefetch(pmemobj_direct(GetGarbage(pos)));
+  }
+
+  /**
+   * @param pos The position of a garbage slot.
+   * @retval true if the slot has not been released yet.
+   * @retval false otherwise.
+   */
+  [[nodiscard]] auto
+  HasGarbage(                  //
+      const size_t pos) const  //
+      -> bool
+  {
+    return !OID_IS_NULL(GetGarbage(pos));
+  }
+
   /*############################################################################
    * Public member variables
    *##########################################################################*/
 
   GarbageListInDRAM *dram{nullptr};
 
-  /// @brief A dummy array for alignment.
-  uint64_t _dummy_for_alignment[1]{};  // NOLINT
+  /// @brief A flag for indicating that this list only stores the offsets of
+  /// garbage (the pool UUID is stored once after the offsets).
+  uint64_t compact{0};
 
   /// @brief The next garbage list if exist.
   PMEMoid next{};
@@ -175,11 +363,53 @@ class GarbageListInPMEM
   PMEMoid tmp{};
 
  private:
+  /*############################################################################
+   * Internal utilities
+   *##########################################################################*/
+
+  /**
+   * @return The head of offsets and the pool UUID in the compact layout.
+   */
+  [[nodiscard]] auto
+  GetOffsets()  //
+      -> uint64_t *
+  {
+    return reinterpret_cast<uint64_t *>(garbages_);
+  }
+
+  /**
+   * @param pos The position of a garbage slot.
+   * @return The address of the offset of the slot.
+   */
+  [[nodiscard]] auto
+  GetOffAddr(            //
+      const size_t pos)  //
+      -> uint64_t *
+  {
+    return compact ? &(GetOffsets()[pos]) : &(garbages_[pos].off);
+  }
+
+  /**
+   * @param pos The position of a garbage slot.
+   * @return The PMEMoid stored in the slot.
+   */
+  [[nodiscard]] auto
+  GetGarbage(                  //
+      const size_t pos) const  //
+      -> PMEMoid
+  {
+    if (compact) {
+      const auto *offsets = reinterpret_cast<const uint64_t *>(garbages_);
+      return PMEMoid{offsets[kBufferSize], offsets[pos]};
+    }
+    return garbages_[pos];
+  }
+
   /*############################################################################
    * Internal member variables
    *##########################################################################*/
 
-  /// @brief Offset values of garbage PMEMoids.
+  /// @brief Garbage PMEMoids (or their offsets in the compact layout).
   PMEMoid garbages_[kBufferSize]{};
 };
 
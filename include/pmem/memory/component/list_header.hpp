@@ -21,6 +21,7 @@
 #include <array>
 #include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -39,6 +40,11 @@
 // local sources
 #include "pmem/memory/component/garbage_list_in_dram.hpp"
 #include "pmem/memory/component/garbage_list_in_pmem.hpp"
+#include "pmem/memory/component/list_stats.hpp"
+#include "pmem/memory/component/owner_word.hpp"
+#include "pmem/memory/component/page_magazine.hpp"
+#include "pmem/memory/component/reserved_intervals.hpp"
+#include "pmem/memory/component/shared_page_pool.hpp"
 #include "pmem/memory/component/tls_fields.hpp"
 #include "pmem/memory/utility.hpp"
 
@@ -59,6 +65,16 @@ class alignas(kCacheLineSize) ListHeader
   using T = typename Target::T;
   using IDManager = ::dbgroup::thread::IDManager;
 
+  /*############################################################################
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief A flag for releasing garbage by PMDK action batches.
+  static constexpr bool kBatch = Target::kReleaseInBatch;
+
+  /// @brief The number of pages prefetched ahead of destruction.
+  static constexpr size_t kPrefetch = Target::kPrefetchDistance;
+
  public:
   /*############################################################################
    * Public constructors and assignment operators
@@ -88,22 +104,74 @@ class alignas(kCacheLineSize) ListHeader
   ~ListHeader()
   {
     if (gc_head_ != nullptr && !OID_IS_NULL(*gc_head_)) {
-      GarbageListInDRAM::Clear<T>(gc_head_, std::numeric_limits<size_t>::max(), gc_tmp_);
+      constexpr auto kMaxEpoch = std::numeric_limits<size_t>::max();
+      GarbageListInDRAM::Clear<T, kBatch, kPrefetch>(gc_head_, kMaxEpoch, gc_tmp_, &gc_stats_);
       delete reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*gc_head_))->dram;
       pmemobj_free(gc_head_);
     }
+    if (shared_pool_ != nullptr) {
+      shared_pool_->ReleaseBatch(&batch_);
+    }
+    if (recycler_.lists != nullptr) {
+      ReleaseCompanions(&(recycler_.lists->ready));
+      ReleaseCompanions(&(recycler_.lists->returned));
+    }
   }
 
   /*############################################################################
    * Public utilities for clients
    *##########################################################################*/
 
+  /**
+   * @brief Assign this list to the current thread.
+   *
+   * If the owner of this list has already exited, this function creates a new
+   * garbage list for the current thread. When the first owner is assigned,
+   * this function also fills the stack of spare lists if given.
+   */
+  void
+  AssignCurrentThreadIfNeeded()
+  {
+    if (owner_.IsOwnedByCurrentThread()) return;
+
+    std::unique_lock guard{owner_};
+    if (!spares_filled_) {
+      FillSpareLists();
+      spares_filled_ = true;
+    }
+    if (OID_IS_NULL(*gc_head_)) {
+      auto *lists = recycler_.lists;
+      if (lists == nullptr || OID_IS_NULL(lists->ready)
+          || !GarbageListInPMEM::MoveList(&(lists->ready), gc_head_)) {
+        GarbageListInPMEM::CreateList(pop_, gc_head_, Target::kCompactSlots);
+      }
+      ListStats::Add(cli_stats_.created_lists);
+      cli_tail_ = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*gc_head_));
+      if (cli_tail_->dram == nullptr) {  // the list is not recycled
+        cli_tail_->dram = new GarbageListInDRAM{};
+      }
+      if constexpr (Target::kReusePages) {
+        cli_head_ = cli_tail_;
+      }
+      if (active_word_ != nullptr) {
+        active_word_->fetch_or(active_mask_, kRelaxed);
+      }
+    }
+    heartbeat_ = IDManager::GetHeartBeat();
+    guard.release();
+    owner_.UnlockAsOwner();  // publish the token of the current thread
+  }
+
   /**
    * @brief Get the temporary field for memory allocation.
    *
+   * @tparam kAssigned A flag for skipping the check of the list owner.
    * @param i the position of fields (0 <= i <= 12).
    * @return the address of the specified temporary field.
+   * @note `kAssigned` may be true only if the current thread has called
+   * `AssignCurrentThreadIfNeeded` for this list.
    */
+  template <bool kAssigned = false>
   auto
   GetTmpField(         //
       const size_t i)  //
@@ -111,36 +179,149 @@ class alignas(kCacheLineSize) ListHeader
   {
     assert(i < kTmpFieldNum);
 
-    AssignCurrentThreadIfNeeded();
+    if constexpr (!kAssigned) AssignCurrentThreadIfNeeded();
     return &(tls_fields_->tmp_oids[i]);
   }
 
   /**
    * @brief Add a new garbage instance.
    *
+   * @tparam kAssigned A flag for skipping the check of the list owner.
    * @param epoch An epoch value when a garbage is added.
    * @param garbage_ptr a pointer to a target garbage.
+   * @param birth An epoch value when the garbage was allocated.
+   * @return The total number of garbage added by the current thread.
+   * @note `birth` is only recorded for interval-based targets.
    */
-  void
+  template <bool kAssigned = false>
+  auto
   AddGarbage(  //
       const size_t epoch,
-      PMEMoid *garbage_ptr)
+      PMEMoid *garbage_ptr,
+      [[maybe_unused]] const size_t birth = 0)  //
+      -> size_t
+  {
+    if constexpr (!kAssigned) AssignCurrentThreadIfNeeded();
+    if constexpr (Target::kIntervalBased) {
+      cli_tail_->dram->SetBirth(birth);
+    }
+    auto *spare = RefillSpareListsIfNeeded();
+    GarbageListInDRAM::AddGarbage(&cli_tail_, epoch, garbage_ptr, pop_, &cli_stats_, spare);
+    ListStats::Add(cli_stats_.added);
+    return ++garbage_cnt_;
+  }
+
+  /**
+   * @brief Add new garbage instances at once.
+   *
+   * @tparam kAssigned A flag for skipping the check of the list owner.
+   * @param epoch An epoch value when garbage is added.
+   * @param garbages Consecutive temporary fields that hold target garbage.
+   * @param n The number of target garbage.
+   * @return The total number of garbage added by the current thread.
+   * @note Given PMEMoids must be in the temporary fields of this list to
+   * prevent them from being released doubly after machine failures.
+   */
+  template <bool kAssigned = false>
+  auto
+  AddGarbages(  //
+      const size_t epoch,
+      PMEMoid *garbages,
+      const size_t n)  //
+      -> size_t
   {
-    AssignCurrentThreadIfNeeded();
-    GarbageListInDRAM::AddGarbage(&cli_tail_, epoch, garbage_ptr, pop_);
+    if constexpr (!kAssigned) AssignCurrentThreadIfNeeded();
+    assert(garbages >= tls_fields_->tmp_oids);
+    assert(garbages + n <= tls_fields_->tmp_oids + kTmpFieldNum);
+
+    auto *spare = RefillSpareListsIfNeeded();
+    GarbageListInDRAM::AddGarbages(&cli_tail_, epoch, garbages, n, pop_, &cli_stats_, spare);
+    ListStats::Add(cli_stats_.added, n);
+    garbage_cnt_ += n;
+    return garbage_cnt_;
   }
 
   /**
    * @brief Reuse a released memory page if it exists in the list.
    *
+   * @tparam kAssigned A flag for skipping the check of the list owner.
    * @param out_page an address to be stored a reusable page.
    */
+  template <bool kAssigned = false>
   void
   GetPageIfPossible(  //
       PMEMoid *out_page)
   {
-    AssignCurrentThreadIfNeeded();
+    if constexpr (!kAssigned) AssignCurrentThreadIfNeeded();
     GarbageListInDRAM::ReusePage(&cli_head_, out_page);
+    if (shared_pool_ != nullptr && OID_IS_NULL(*out_page)) {
+      shared_pool_->ReusePage(&batch_, out_page);
+    }
+
+    if (OID_IS_NULL(*out_page)) {
+      ListStats::Add(cli_stats_.reuse_misses);
+    } else {
+      ListStats::Add(cli_stats_.reused);
+      ListStats::Add(cli_stats_.persist_num);
+    }
+  }
+
+  /**
+   * @brief Allocate a new page without reusing garbage.
+   *
+   * @param pop A pmemobj pool for allocating a page.
+   * @param[out] out_oid A PMEMoid to store an allocated page.
+   * @param size The size of a page.
+   * @note If `kMagazineSize` is not zero, pages are reserved in bulk and
+   * published one by one to avoid calling the PMDK allocator for each page.
+   */
+  void
+  AllocatePage(  //
+      PMEMobjpool *pop,
+      PMEMoid *out_oid,
+      const size_t size)
+  {
+    if constexpr (Target::kMagazineSize == 0) {
+      Malloc(pop, out_oid, size);
+    } else {
+      if (!magazine_) {
+        magazine_ = std::make_unique<PageMagazine>(Target::kMagazineSize);
+      }
+      magazine_->Allocate(pop, out_oid, size);
+    }
+  }
+
+  /**
+   * @return The number of garbage lists that this header holds.
+   * @note This function may be called only by the owner thread.
+   */
+  [[nodiscard]] auto
+  GetLiveListNum() const  //
+      -> size_t
+  {
+    const auto created = cli_stats_.created_lists.load(kRelaxed);
+    const auto removed = gc_stats_.removed_lists.load(kRelaxed);
+    return created > removed ? created - removed : 0;
+  }
+
+  /**
+   * @return Statistics counters updated by client threads.
+   */
+  [[nodiscard]] auto
+  GetClientStats() const  //
+      -> const ListStats &
+  {
+    return cli_stats_;
+  }
+
+  /**
+   * @return Statistics counters updated by cleaner threads.
+   */
+  [[nodiscard]] auto
+  GetGCStats() const  //
+      -> const ListStats &
+  {
+    return gc_stats_;
   }
 
   /*############################################################################
@@ -150,49 +331,163 @@ class alignas(kCacheLineSize) ListHeader
   /**
    * @param pop a pmemobj_pool instance for allocation.
    * @param tls thread-local fields.
+   * @param active_word a word of a bitmap for tracking active lists.
+   * @param active_mask a bit mask that represents this list in the word.
+   * @note If `active_word` is given, this list sets its bit in the word while
+   * it has the head of garbage lists.
    */
   void
   SetPMEMInfo(  //
       PMEMobjpool *pop,
-      TLSFields *tls)
+      TLSFields *tls,
+      std::atomic_uint64_t *active_word = nullptr,
+      const uint64_t active_mask = 0)
   {
+    active_word_ = active_word;
+    active_mask_ = active_mask;
     pop_ = pop;
     tls_fields_ = tls;
     gc_head_ = &(tls_fields_->head);
     gc_tmp_ = &(tls_fields_->tmp_head);
   }
 
+  /**
+   * @brief Use additional heads instead of those in thread-local fields.
+   *
+   * @param head the head pointer of garbage lists.
+   * @param tmp_head a temporary field to swap head pointers.
+   * @note This function must be called after `SetPMEMInfo`.
+   */
+  void
+  SetListHeads(  //
+      PMEMoid *head,
+      PMEMoid *tmp_head)
+  {
+    gc_head_ = head;
+    gc_tmp_ = tmp_head;
+  }
+
+  /**
+   * @brief Recycle drained lists by given persistent stacks.
+   *
+   * @param lists persistent stacks of spare lists.
+   * @param capacity the maximum number of lists in each stack.
+   * @note This function prepares companion lists in DRAM for the kept spare
+   * lists, and so it must be called before any client thread uses this list.
+   * New spare lists are allocated when a client thread first uses this list.
+   */
+  void
+  SetSpareLists(  //
+      SpareLists *lists,
+      const size_t capacity)
+  {
+    recycler_.lists = lists;
+    recycler_.capacity = capacity;
+    recycler_.returned_num.store(PrepareCompanions(&(lists->returned)), kRelaxed);
+    ready_num_ = PrepareCompanions(&(lists->ready));
+  }
+
+  /**
+   * @param pool a pool for sharing destructed pages among threads.
+   */
+  void
+  SetSharedPool(  //
+      SharedPagePool *pool)
+  {
+    shared_pool_ = pool;
+  }
+
   /**
    * @brief Release registered garbage if possible.
    *
    * @param protected_epoch an epoch value to check whether garbage can be freed.
+   * @param intervals a snapshot of reserved epochs for interval-based targets.
+   * @param max_num the maximum number of garbage to be reclaimed in this call.
+   * @retval true if this list may still have garbage to be collected.
+   * @retval false otherwise.
    */
-  void
+  auto
   ClearGarbage(  //
-      const size_t protected_epoch)
+      const size_t protected_epoch,
+      [[maybe_unused]] const ReservedIntervals *intervals = nullptr,
+      const size_t max_num = std::numeric_limits<size_t>::max())  //
+      -> bool
   {
-    std::unique_lock guard{mtx_, std::defer_lock};
-    if (!guard.try_lock() || gc_head_ == nullptr || OID_IS_NULL(*gc_head_)) return;
+    std::unique_lock guard{owner_, std::defer_lock};
+    if (!guard.try_lock()) return true;
+    if (gc_head_ == nullptr || OID_IS_NULL(*gc_head_)) return false;
 
     // destruct or release garbages
+    bool has_garbage{};
+    auto *recycler = recycler_.lists == nullptr ? nullptr : &recycler_;
     if constexpr (!Target::kReusePages) {
-      GarbageListInDRAM::Clear<T>(gc_head_, protected_epoch, gc_tmp_);
+      has_garbage = GarbageListInDRAM::Clear<T, kBatch, kPrefetch>(  //
+          gc_head_, protected_epoch, gc_tmp_, &gc_stats_, recycler, max_num);
+      if constexpr (Target::kIntervalBased) {
+        if (has_garbage && intervals != nullptr && !intervals->intervals.empty()) {
+          GarbageListInDRAM::ClearByIntervals<T>(gc_head_, *intervals);
+        }
+      }
     } else {
       if (!heartbeat_.expired()) {
-        GarbageListInDRAM::Destruct<T>(gc_head_, protected_epoch, gc_tmp_);
-        return;
+        return GarbageListInDRAM::Destruct<T, kBatch, kPrefetch>(  //
+            gc_head_, protected_epoch, gc_tmp_, &gc_stats_, recycler, shared_pool_, max_num);
       }
-      GarbageListInDRAM::Clear<T>(gc_head_, protected_epoch, gc_tmp_);
+      if (shared_pool_ != nullptr) {
+        shared_pool_->ReleaseBatch(&batch_);
+      }
+      has_garbage = GarbageListInDRAM::Clear<T, kBatch, kPrefetch>(  //
+          gc_head_, protected_epoch, gc_tmp_, &gc_stats_, recycler, max_num);
       cli_head_ = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*gc_head_));
     }
 
     auto *dram = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*gc_head_))->dram;
-    if (!heartbeat_.expired() || !dram->Empty()) return;
+    if (!heartbeat_.expired() || !dram->Empty()) return has_garbage;
 
     delete dram;
     cli_tail_ = nullptr;
     cli_head_ = nullptr;
     pmemobj_free(gc_head_);
+    ListStats::Add(gc_stats_.removed_lists);
+    ListStats::Add(gc_stats_.free_num);
+    if (active_word_ != nullptr) {
+      active_word_->fetch_and(~active_mask_, kRelaxed);
+    }
+    return false;
+  }
+
+  /**
+   * @brief Release all the garbage in this list regardless of epochs.
+   *
+   * @note This function must not be called concurrently with client threads.
+   */
+  void
+  Drain()
+  {
+    std::lock_guard guard{owner_};
+    if (gc_head_ == nullptr || OID_IS_NULL(*gc_head_)) return;
+
+    constexpr auto kMaxEpoch = std::numeric_limits<size_t>::max();
+    GarbageListInDRAM::Clear<T, kBatch, kPrefetch>(gc_head_, kMaxEpoch, gc_tmp_, &gc_stats_);
+  }
+
+  /**
+   * @brief Leave the garbage lists in persistent memory without releasing them.
+   *
+   * The destructor only releases companion lists in DRAM after this function,
+   * and the left garbage is released without destruction by recovery in the
+   * next construction.
+   *
+   * @note This function must not be called concurrently with client threads.
+   */
+  void
+  Detach()
+  {
+    std::lock_guard guard{owner_};
+    if (gc_head_ == nullptr) return;
+
+    ReleaseCompanions(gc_head_);
+    gc_head_ = nullptr;
   }
 
  private:
@@ -201,31 +496,95 @@ class alignas(kCacheLineSize) ListHeader
    *##########################################################################*/
 
   /**
-   * @brief Assign this list to the current thread.
+   * @brief Fill the stack of ready lists up to its capacity.
    *
+   * @note This function must be called with the lock of this header.
    */
   void
-  AssignCurrentThreadIfNeeded()
+  FillSpareLists()
   {
-    if (!heartbeat_.expired()) return;
+    auto *lists = recycler_.lists;
+    if (lists == nullptr) return;
 
-    std::lock_guard guard{mtx_};
-    if (OID_IS_NULL(*gc_head_)) {
-      Zalloc(pop_, gc_head_, sizeof(GarbageListInPMEM));
-      cli_tail_ = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*gc_head_));
-      cli_tail_->dram = new GarbageListInDRAM{};
-      if constexpr (Target::kReusePages) {
-        cli_head_ = cli_tail_;
+    auto *addr = &(lists->ready);
+    for (auto cnt = ready_num_; cnt < recycler_.capacity; ++cnt) {
+      while (!OID_IS_NULL(*addr)) {
+        addr = &(reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*addr))->next);
       }
+      GarbageListInPMEM::CreateList(pop_, addr, Target::kCompactSlots);
+      reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*addr))->dram = new GarbageListInDRAM{};
+    }
+  }
+
+  /**
+   * @brief Move returned lists to ready ones if there is no ready list.
+   *
+   * @return The address of a stack of ready lists if exist.
+   * @note If cleaner threads hold the lock, this function does nothing and
+   * the current thread allocates a new list if needed.
+   */
+  auto
+  RefillSpareListsIfNeeded()  //
+      -> PMEMoid *
+  {
+    auto *lists = recycler_.lists;
+    if (lists == nullptr) return nullptr;
+    if (!OID_IS_NULL(lists->ready) || recycler_.returned_num.load(kRelaxed) == 0) {
+      return &(lists->ready);
+    }
+
+    std::unique_lock guard{owner_, std::try_to_lock};
+    if (guard && GarbageListInPMEM::MoveAllLists(&(lists->returned), &(lists->ready))) {
+      recycler_.returned_num.store(0, kRelaxed);
+    }
+    return &(lists->ready);
+  }
+
+  /**
+   * @brief Create companion lists in DRAM for spare lists.
+   *
+   * @param head_addr the address of a PMEMoid that refers to spare lists.
+   * @return the number of spare lists.
+   * @note Spare lists may have dangling pointers to companion lists of the
+   * previous run, and so this function overwrites them.
+   */
+  static auto
+  PrepareCompanions(             //
+      const PMEMoid *head_addr)  //
+      -> size_t
+  {
+    size_t cnt = 0;
+    for (auto oid = *head_addr; !OID_IS_NULL(oid); ++cnt) {
+      auto *list = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(oid));
+      list->dram = new GarbageListInDRAM{};
+      oid = list->next;
+    }
+    return cnt;
+  }
+
+  /**
+   * @brief Release companion lists in DRAM of spare lists.
+   *
+   * @param head_addr the address of a PMEMoid that refers to spare lists.
+   */
+  static void
+  ReleaseCompanions(  //
+      const PMEMoid *head_addr)
+  {
+    for (auto oid = *head_addr; !OID_IS_NULL(oid);) {
+      auto *list = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(oid));
+      delete list->dram;
+      list->dram = nullptr;
+      oid = list->next;
     }
-    heartbeat_ = IDManager::GetHeartBeat();
   }
 
   /*############################################################################
    * Internal member variables
    *##########################################################################*/
 
-  /// @brief A flag for indicating the corresponding thread has exited.
+  /// @brief A flag for indicating the corresponding thread has exited (only
+  /// accessed with the lock).
   std::weak_ptr<size_t> heartbeat_{};
 
   /// @brief A garbage list that has destructed pages.
@@ -240,17 +599,48 @@ class alignas(kCacheLineSize) ListHeader
   /// @brief The pointer to the thread local fields.
   TLSFields *tls_fields_{nullptr};
 
-  /// @brief A dummy array for alignment.
-  uint64_t dummy_for_alignment_[2]{};
+  /// @brief The number of garbage added by client threads.
+  size_t garbage_cnt_{0};
+
+  /// @brief A word of a bitmap for tracking lists that have garbage.
+  std::atomic_uint64_t *active_word_{nullptr};
 
-  /// @brief A mutex instance for modifying buffer pointers.
-  std::mutex mtx_{};
+  /// @brief A bit mask that represents this list in the bitmap.
+  uint64_t active_mask_{0};
+
+  /// @brief The owner thread of this list and a lock for modifying buffer
+  /// pointers.
+  OwnerWord owner_{};
 
   /// @brief The head of garbage lists.
   PMEMoid *gc_head_{nullptr};
 
   /// @brief A temporary region for swapping PMEMoids.
   PMEMoid *gc_tmp_{nullptr};
+
+  /// @brief A pool for sharing destructed pages among threads.
+  SharedPagePool *shared_pool_{nullptr};
+
+  /// @brief A batch of pages claimed from the shared pool.
+  SharedPagePool::Batch batch_{};
+
+  /// @brief Statistics counters updated by client threads.
+  ListStats cli_stats_{};
+
+  /// @brief Statistics counters updated by cleaner threads.
+  ListStats gc_stats_{};
+
+  /// @brief Stacks of spare lists for recycling drained lists.
+  GarbageListInDRAM::Recycler recycler_{};
+
+  /// @brief The number of ready lists kept from the previous run.
+  size_t ready_num_{0};
+
+  /// @brief A flag for indicating the ready lists have been filled.
+  bool spares_filled_{false};
+
+  /// @brief Pages reserved in bulk for allocation.
+  std::unique_ptr<PageMagazine> magazine_{};
 };
 
 }  // namespace dbgroup::pmem::memory::component
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMEM_MEMORY_COMPONENT_LIST_STATS_HPP
+#define PMEM_MEMORY_COMPONENT_LIST_STATS_HPP
+
+// C++ standard libraries
+#include <atomic>
+#include <cstddef>
+
+// local sources
+#include "pmem/memory/utility.hpp"
+
+namespace dbgroup::pmem::memory::component
+{
+/**
+ * @brief A struct for holding statistics counters of a garbage list.
+ *
+ * Each instance must be updated by a single thread (i.e., a client thread or
+ * a cleaner thread that holds the lock of a list), and so counters are only
+ * loaded and stored with relaxed ordering. Other threads can read counters at
+ * any time to create a snapshot of statistics.
+ */
+struct alignas(kCacheLineSize) ListStats {
+  /*############################################################################
+   * Public member variables
+   *##########################################################################*/
+
+  /// @brief The number of added garbage.
+  std::atomic_size_t added{0};
+
+  /// @brief The number of destructed garbage.
+  std::atomic_size_t destructed{0};
+
+  /// @brief The number of released garbage.
+  std::atomic_size_t released{0};
+
+  /// @brief The number of reused pages.
+  std::atomic_size_t reused{0};
+
+  /// @brief The number of requests for reusable pages without any page.
+  std::atomic_size_t reuse_misses{0};
+
+  /// @brief The number of allocated `GarbageListInPMEM` blocks.
+  std::atomic_size_t created_lists{0};
+
+  /// @brief The number of released or donated `GarbageListInPMEM` blocks.
+  std::atomic_size_t removed_lists{0};
+
+  /// @brief The number of `pmem_persist` calls.
+  std::atomic_size_t persist_num{0};
+
+  /// @brief The number of PMDK free operations (including deferred ones).
+  std::atomic_size_t free_num{0};
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Increment a counter without any atomic read-modify-write.
+   *
+   * @param counter A target counter in this instance.
+   * @param n An increment.
+   */
+  static void
+  Add(  //
+      std::atomic_size_t &counter,
+      const size_t n = 1)
+  {
+    counter.store(counter.load(kRelaxed) + n, kRelaxed);
+  }
+};
+
+}  // namespace dbgroup::pmem::memory::component
+
+#endif  // PMEM_MEMORY_COMPONENT_LIST_STATS_HPP
@@ -0,0 +1,162 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMEM_MEMORY_COMPONENT_OWNER_WORD_HPP
+#define PMEM_MEMORY_COMPONENT_OWNER_WORD_HPP
+
+// C++ standard libraries
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// local sources
+#include "pmem/memory/utility.hpp"
+
+namespace dbgroup::pmem::memory::component
+{
+/**
+ * @brief A word for representing the owner of a list and its lock.
+ *
+ * The lower bits hold a token of the owner thread, and the most significant bit
+ * represents that a thread modifies the list. Since each token is unique to a
+ * lifetime of a thread, an owner thread can check its ownership by comparing
+ * its thread-local token without any atomic read-modify-write, and cleaner
+ * threads claim the list by a single CAS. This class satisfies the Lockable
+ * requirements, and so it can be used with `std::unique_lock`.
+ */
+class OwnerWord
+{
+ public:
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new instance without any owner.
+   *
+   */
+  constexpr OwnerWord() = default;
+
+  OwnerWord(const OwnerWord &) = delete;
+  OwnerWord(OwnerWord &&) = delete;
+
+  auto operator=(const OwnerWord &) -> OwnerWord & = delete;
+  auto operator=(OwnerWord &&) -> OwnerWord & = delete;
+
+  /*############################################################################
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the instance.
+   *
+   */
+  ~OwnerWord() = default;
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @return A token unique to the lifetime of the current thread.
+   */
+  static auto
+  GetCurrentToken()  //
+      -> uint64_t
+  {
+    static std::atomic_uint64_t counter{0};
+    thread_local const uint64_t token = counter.fetch_add(1, kRelaxed) + 1;
+    return token;
+  }
+
+  /**
+   * @retval true if the current thread owns this word.
+   * @retval false otherwise.
+   * @note Only an owner thread can rely on the result because other threads
+   * may change the owner after this check.
+   */
+  [[nodiscard]] auto
+  IsOwnedByCurrentThread() const  //
+      -> bool
+  {
+    return (word_.load(kRelaxed) & ~kLocked) == GetCurrentToken();
+  }
+
+  /**
+   * @brief Set the current thread as the owner.
+   *
+   * @note This function must be called with the lock, and it releases the lock.
+   */
+  void
+  UnlockAsOwner()
+  {
+    word_.store(GetCurrentToken(), kRelease);
+  }
+
+  /**
+   * @brief Acquire the lock by spinning.
+   *
+   */
+  void
+  lock()
+  {
+    while (!try_lock()) {
+      std::this_thread::yield();
+    }
+  }
+
+  /**
+   * @retval true if the lock is acquired.
+   * @retval false if another thread holds the lock.
+   */
+  auto
+  try_lock()  //
+      -> bool
+  {
+    auto cur = word_.load(kRelaxed);
+    if ((cur & kLocked) != 0) return false;
+    return word_.compare_exchange_strong(cur, cur | kLocked, kAcquire, kRelaxed);
+  }
+
+  /**
+   * @brief Release the lock.
+   *
+   */
+  void
+  unlock()
+  {
+    word_.fetch_and(~kLocked, kRelease);
+  }
+
+ private:
+  /*############################################################################
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief A flag for indicating a thread holds the lock.
+  static constexpr uint64_t kLocked = 1UL << 63UL;
+
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief The token of the owner and the lock flag.
+  std::atomic_uint64_t word_{0};
+};
+
+}  // namespace dbgroup::pmem::memory::component
+
+#endif  // PMEM_MEMORY_COMPONENT_OWNER_WORD_HPP
@@ -0,0 +1,149 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMEM_MEMORY_COMPONENT_PAGE_MAGAZINE_HPP
+#define PMEM_MEMORY_COMPONENT_PAGE_MAGAZINE_HPP
+
+// C++ standard libraries
+#include <cstddef>
+#include <memory>
+
+// external system libraries
+#include <libpmemobj.h>
+
+// local sources
+#include "pmem/memory/utility.hpp"
+
+namespace dbgroup::pmem::memory::component
+{
+/**
+ * @brief A class for holding pages reserved in bulk by a thread.
+ *
+ * This class reserves pages by `pmemobj_reserve` at once and publishes them one
+ * by one. Since reserved pages are volatile until publication, machine failures
+ * do not leak the pages held by a magazine.
+ */
+class PageMagazine
+{
+ public:
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new instance.
+   *
+   * @param capacity The number of pages reserved at once.
+   */
+  explicit PageMagazine(  //
+      size_t capacity);
+
+  PageMagazine(const PageMagazine &) = delete;
+  PageMagazine(PageMagazine &&) = delete;
+
+  auto operator=(const PageMagazine &) -> PageMagazine & = delete;
+  auto operator=(PageMagazine &&) -> PageMagazine & = delete;
+
+  /*############################################################################
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the instance.
+   *
+   * This destructor cancels all the reservations that have not been published,
+   * and so the pool of the reserved pages must be open.
+   */
+  ~PageMagazine();
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Publish a reserved page and store it in a given field.
+   *
+   * @param[in] pop A pmemobj pool for allocating pages.
+   * @param[out] out_oid A PMEMoid to store an allocated page.
+   * @param[in] size The size of a page.
+   * @note If this magazine is empty or holds pages of another pool or size, it
+   * reserves new pages in bulk.
+   * @note If `out_oid` is in the pool of pages, the page and `out_oid` are
+   * published atomically, and so machine failures do not leak the page.
+   */
+  void Allocate(  //
+      PMEMobjpool *pop,
+      PMEMoid *out_oid,
+      size_t size);
+
+ private:
+  /*############################################################################
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief The number of actions for publishing a page and its destination.
+  static constexpr size_t kAllocActionNum = 3;
+
+  /*############################################################################
+   * Internal utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Publish given actions or cancel them if failed.
+   *
+   * @param acts Actions to be published.
+   * @param n The number of actions.
+   */
+  void Publish(  //
+      pobj_action *acts,
+      size_t n);
+
+  /**
+   * @brief Cancel the remaining reservations and reserve new pages.
+   *
+   * @param pop A pmemobj pool for allocating pages.
+   * @param size The size of a page.
+   */
+  void Refill(  //
+      PMEMobjpool *pop,
+      size_t size);
+
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief The number of pages reserved at once.
+  const size_t capacity_{0};
+
+  /// @brief The number of reserved pages.
+  size_t num_{0};
+
+  /// @brief The size of reserved pages.
+  size_t size_{0};
+
+  /// @brief The pool of reserved pages.
+  PMEMobjpool *pop_{nullptr};
+
+  /// @brief Reservation actions of pages.
+  std::unique_ptr<pobj_action[]> acts_{};
+
+  /// @brief Reserved pages.
+  std::unique_ptr<PMEMoid[]> oids_{};
+};
+
+}  // namespace dbgroup::pmem::memory::component
+
+#endif  // PMEM_MEMORY_COMPONENT_PAGE_MAGAZINE_HPP
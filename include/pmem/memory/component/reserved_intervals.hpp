@@ -0,0 +1,74 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMEM_MEMORY_COMPONENT_RESERVED_INTERVALS_HPP
+#define PMEM_MEMORY_COMPONENT_RESERVED_INTERVALS_HPP
+
+// C++ standard libraries
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace dbgroup::pmem::memory::component
+{
+/**
+ * @brief A struct for holding a snapshot of epochs reserved by client threads.
+ *
+ * Cleaner threads create this snapshot before each pass. Epoch guards protect
+ * all the garbage retired in or after their epochs, whereas interval guards
+ * only protect garbage whose lifetime overlaps their reserved intervals.
+ */
+struct ReservedIntervals {
+  /*############################################################################
+   * Public member variables
+   *##########################################################################*/
+
+  /// @brief The minimum epoch protected by any guard.
+  size_t protected_epoch{0};
+
+  /// @brief The minimum epoch protected by epoch guards.
+  size_t min_epoch{0};
+
+  /// @brief The closed intervals `[lower, upper]` reserved by interval guards.
+  std::vector<std::pair<size_t, size_t>> intervals{};
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @param birth An epoch when a page was allocated.
+   * @param retire An epoch when the page was retired as garbage.
+   * @retval true if no guard in this snapshot can refer to the page.
+   * @retval false otherwise.
+   */
+  [[nodiscard]] auto
+  CanRelease(  //
+      const size_t birth,
+      const size_t retire) const  //
+      -> bool
+  {
+    if (retire >= min_epoch) return false;
+    for (const auto &[lower, upper] : intervals) {
+      if (birth <= upper && retire >= lower) return false;
+    }
+    return true;
+  }
+};
+
+}  // namespace dbgroup::pmem::memory::component
+
+#endif  // PMEM_MEMORY_COMPONENT_RESERVED_INTERVALS_HPP
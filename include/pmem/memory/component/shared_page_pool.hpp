@@ -0,0 +1,198 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMEM_MEMORY_COMPONENT_SHARED_PAGE_POOL_HPP
+#define PMEM_MEMORY_COMPONENT_SHARED_PAGE_POOL_HPP
+
+// C++ standard libraries
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+// external system libraries
+#include <libpmemobj.h>
+
+// local sources
+#include "pmem/memory/component/garbage_list_in_pmem.hpp"
+#include "pmem/memory/component/tls_fields.hpp"
+#include "pmem/memory/utility.hpp"
+
+namespace dbgroup::pmem::memory::component
+{
+/**
+ * @brief A class for sharing destructed pages among threads.
+ *
+ * Garbage lists donate their surplus lists that only have destructed pages to
+ * this pool, and threads that do not have reusable pages claim a batch of
+ * pages from this pool. Donated lists are linked to the head in `TLSFields`
+ * by PMDK action batches, so each page always belongs to exactly one list.
+ * When a thread reuses a page, the page is moved to its temporary field in
+ * the same way as thread-local reuse.
+ */
+class SharedPagePool
+{
+  /*############################################################################
+   * Internal classes
+   *##########################################################################*/
+
+  /**
+   * @brief Volatile information of a donated list.
+   *
+   */
+  struct Block {
+    /// @brief A donated list.
+    GarbageListInPMEM *pmem{nullptr};
+
+    /// @brief The number of claimed pages.
+    size_t claimed{0};
+
+    /// @brief The number of reused or released pages.
+    std::atomic_size_t popped{0};
+  };
+
+ public:
+  /*############################################################################
+   * Public classes
+   *##########################################################################*/
+
+  /**
+   * @brief A batch of pages claimed by a thread.
+   *
+   */
+  struct Batch {
+    /// @brief A list that contains the pages.
+    Block *block{nullptr};
+
+    /// @brief The position of the first claimed page.
+    size_t begin{0};
+
+    /// @brief The position of the next page to be reused.
+    size_t pos{0};
+
+    /// @brief The position next to the last claimed page.
+    size_t end{0};
+  };
+
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new instance.
+   *
+   * @param tls Persistent fields for holding donated lists.
+   * @param capacity The maximum number of pages in this pool.
+   */
+  SharedPagePool(  //
+      TLSFields *tls,
+      size_t capacity);
+
+  SharedPagePool(const SharedPagePool &) = delete;
+  SharedPagePool(SharedPagePool &&) = delete;
+
+  auto operator=(const SharedPagePool &) -> SharedPagePool & = delete;
+  auto operator=(SharedPagePool &&) -> SharedPagePool & = delete;
+
+  /*############################################################################
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the instance.
+   *
+   * This destructor releases all the pages that have not been reused.
+   */
+  ~SharedPagePool();
+
+  /*############################################################################
+   * Public utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Donate a list that only has destructed pages.
+   *
+   * @param list_addr The address of a PMEMoid that refers to a target list.
+   * @retval true if the list is moved to this pool and `list_addr` refers to
+   * its next list.
+   * @retval false if this pool is full.
+   * @note The list must be unreachable from client threads.
+   */
+  auto Donate(             //
+      PMEMoid *list_addr)  //
+      -> bool;
+
+  /**
+   * @brief Reuse a page in a claimed batch or claim a new batch.
+   *
+   * @param[in,out] batch The batch of pages claimed by the current thread.
+   * @param[out] out_page The address of a PMEMoid to store a reusable page.
+   */
+  void ReusePage(  //
+      Batch *batch,
+      PMEMoid *out_page);
+
+  /**
+   * @brief Release the remaining pages in a given batch.
+   *
+   * @param[in,out] batch The batch of pages claimed by an exited thread.
+   */
+  void ReleaseBatch(  //
+      Batch *batch);
+
+ private:
+  /*############################################################################
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief The number of pages claimed at once.
+  static constexpr size_t kBatchSize = 32;
+
+  /*############################################################################
+   * Internal utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Release lists whose pages have been reused or released.
+   *
+   * @note This function must be called with the lock.
+   */
+  void RemovePoppedBlocks();
+
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief The maximum number of donated lists.
+  const size_t capacity_{0};
+
+  /// @brief The number of pages that have not been claimed.
+  std::atomic_size_t unclaimed_{0};
+
+  /// @brief Persistent fields for holding donated lists.
+  TLSFields *tls_{nullptr};
+
+  /// @brief A mutex for modifying donated lists.
+  std::mutex mtx_{};
+
+  /// @brief Donated lists in the order of their persistent links.
+  std::deque<std::unique_ptr<Block>> blocks_{};
+};
+
+}  // namespace dbgroup::pmem::memory::component
+
+#endif  // PMEM_MEMORY_COMPONENT_SHARED_PAGE_POOL_HPP
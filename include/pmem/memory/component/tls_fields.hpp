@@ -65,6 +65,41 @@ struct TLSFields {
       -> PMEMoid *;
 };
 
+/**
+ * @brief A class for representing heads of additional garbage lists.
+ *
+ */
+struct ListHeads {
+  /*############################################################################
+   * Public member variables
+   *##########################################################################*/
+
+  /// @brief The head pointer of garbage lists.
+  PMEMoid head{};
+
+  /// @brief A temporary field to swap head pointers.
+  PMEMoid tmp_head{};
+};
+
+/**
+ * @brief A class for representing stacks of spare garbage lists.
+ *
+ * A client thread takes spare lists from `ready`, and cleaner threads return
+ * drained lists to `returned`. When `ready` becomes empty, the client thread
+ * moves all the lists in `returned` to `ready` at once.
+ */
+struct SpareLists {
+  /*############################################################################
+   * Public member variables
+   *##########################################################################*/
+
+  /// @brief Spare lists to be reused by a client thread.
+  PMEMoid ready{};
+
+  /// @brief Drained lists returned by cleaner threads.
+  PMEMoid returned{};
+};
+
 }  // namespace dbgroup::pmem::memory::component
 
 #endif  // PMEM_MEMORY_COMPONENT_TLS_FIELDS_HPP
@@ -0,0 +1,300 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMEM_MEMORY_COMPONENT_VOLATILE_GARBAGE_LIST_HPP
+#define PMEM_MEMORY_COMPONENT_VOLATILE_GARBAGE_LIST_HPP
+
+// C++ standard libraries
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+// local sources
+#include "pmem/memory/component/list_stats.hpp"
+#include "pmem/memory/utility.hpp"
+
+namespace dbgroup::pmem::memory::component
+{
+/**
+ * @brief A class to represent a buffer of garbage pointers in DRAM.
+ *
+ * This class follows the same protocol as `GarbageListInDRAM`, but garbage is
+ * given as plain pointers and released by `::operator delete` without any
+ * persistence.
+ */
+class alignas(kCacheLineSize) VolatileGarbageList
+{
+ public:
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new instance.
+   *
+   */
+  constexpr VolatileGarbageList() = default;
+
+  VolatileGarbageList(const VolatileGarbageList &) = delete;
+  VolatileGarbageList(VolatileGarbageList &&) = delete;
+
+  auto operator=(const VolatileGarbageList &) -> VolatileGarbageList & = delete;
+  auto operator=(VolatileGarbageList &&) -> VolatileGarbageList & = delete;
+
+  /*############################################################################
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the instance.
+   *
+   */
+  ~VolatileGarbageList() = default;
+
+  /*############################################################################
+   * Public getters/setters
+   *##########################################################################*/
+
+  /**
+   * @retval true if this list is empty.
+   * @retval false otherwise
+   */
+  [[nodiscard]] auto Empty() const  //
+      -> bool;
+
+  /*############################################################################
+   * Public utility functions
+   *##########################################################################*/
+
+  /**
+   * @brief Add a new garbage instance to the list tail.
+   *
+   * @param[in,out] list_addr The address of the pointer of a target list.
+   * @param[in] epoch An epoch in which garbage was added.
+   * @param[in] garbage A new garbage instance.
+   * @param[in,out] stats Statistics counters of a client thread.
+   * @note If the list becomes full, this function creates a new list and link
+   * them.
+   */
+  static void AddGarbage(  //
+      VolatileGarbageList **list_addr,
+      size_t epoch,
+      void *garbage,
+      ListStats *stats);
+
+  /**
+   * @brief Reuse a destructed page.
+   *
+   * @param[in,out] list_addr The address of the pointer of a target list.
+   * @return A reusable page if exist (nullptr otherwise).
+   */
+  static auto ReusePage(                //
+      VolatileGarbageList **list_addr)  //
+      -> void *;
+
+  /**
+   * @brief Destruct garbage if its epoch is less than a protected epoch.
+   *
+   * @tparam T A class that has a target destruction procedure.
+   * @param[in,out] list_addr The address of the head of target lists.
+   * @param[in] protected_epoch A protected epoch.
+   * @param[in,out] stats Statistics counters of a cleaner thread.
+   * @retval true if the list still has garbage to be destructed.
+   * @retval false otherwise.
+   */
+  template <class T>
+  static auto
+  Destruct(  //
+      VolatileGarbageList **list_addr,
+      const size_t protected_epoch,
+      ListStats *stats)  //
+      -> bool
+  {
+    VolatileGarbageList *reuse_head = nullptr;
+
+    while (true) {
+      auto *list = *list_addr;
+
+      // destruct obsolete garbage
+      const auto end_pos = list->end_pos_.load(kAcquire);
+      const auto begin_mid = list->mid_pos_.load(kRelaxed);
+      const auto mid_pos = FindProtectedPos(list->epochs_, begin_mid, end_pos, protected_epoch);
+      if constexpr (!std::is_same_v<T, void>) {
+        for (auto i = begin_mid; i < mid_pos; ++i) {
+          static_cast<T *>(list->garbages_[i])->~T();
+        }
+      }
+      list->mid_pos_.store(mid_pos, kRelease);
+      ListStats::Add(stats->destructed, mid_pos - begin_mid);
+      if (mid_pos < kBufferSize) return mid_pos < end_pos;
+
+      // check the list can be released
+      auto pos = list->begin_pos_.load(kAcquire);
+      if (pos > 0) {
+        reuse_head = nullptr;
+        if (pos < kBufferSize) {
+          list_addr = &(list->gc_next_);
+        } else {
+          RemoveHead(list_addr, stats);
+        }
+        continue;
+      }
+
+      // fount the fully destructed list
+      if (reuse_head != nullptr && reuse_head->begin_pos_.load(kRelaxed) == 0) {
+        auto cur = reuse_head->next_.load(kRelaxed);
+        const auto next = list->next_.load(kRelaxed);
+        if ((cur & kUsed) == 0
+            && reuse_head->next_.compare_exchange_strong(cur, next, kRelease, kRelaxed)) {
+          for (size_t i = pos; i < kBufferSize; ++i) {
+            ::operator delete(list->garbages_[i]);
+          }
+          ListStats::Add(stats->released, kBufferSize - pos);
+          RemoveHead(list_addr, stats);
+          continue;
+        }
+      }
+      reuse_head = list;
+      list_addr = &(list->gc_next_);
+    }
+  }
+
+  /**
+   * @brief Release garbage if its epoch is less than a protected epoch.
+   *
+   * @tparam T A class that has a target destruction procedure.
+   * @param[in,out] list_addr The address of the head of target lists.
+   * @param[in] protected_epoch A protected epoch.
+   * @param[in,out] stats Statistics counters of a cleaner thread.
+   * @retval true if the list still has garbage to be released.
+   * @retval false otherwise.
+   */
+  template <class T>
+  static auto
+  Clear(  //
+      VolatileGarbageList **list_addr,
+      const size_t protected_epoch,
+      ListStats *stats)  //
+      -> bool
+  {
+    while (true) {
+      auto *list = *list_addr;
+
+      const auto mid_pos = list->mid_pos_.load(kRelaxed);
+      const auto begin_pos = list->begin_pos_.load(kRelaxed);
+      const auto end_pos = list->end_pos_.load(kAcquire);
+      const auto pos = FindProtectedPos(list->epochs_, mid_pos, end_pos, protected_epoch);
+      if constexpr (!std::is_same_v<T, void>) {
+        for (auto i = mid_pos; i < pos; ++i) {
+          static_cast<T *>(list->garbages_[i])->~T();
+        }
+      }
+      for (auto i = begin_pos; i < pos; ++i) {
+        ::operator delete(list->garbages_[i]);
+      }
+      list->begin_pos_.store(pos, kRelaxed);
+      list->mid_pos_.store(pos, kRelaxed);
+      ListStats::Add(stats->destructed, pos - mid_pos);
+      ListStats::Add(stats->released, pos - begin_pos);
+      if (pos < kBufferSize) return pos < end_pos;
+
+      RemoveHead(list_addr, stats);
+    }
+  }
+
+ private:
+  /*############################################################################
+   * Internal constants
+   *##########################################################################*/
+
+  static constexpr auto kUsed = 1UL << 63UL;
+
+  /*############################################################################
+   * Internal utilities
+   *##########################################################################*/
+
+  /**
+   * @brief Find the first garbage protected by a given epoch.
+   *
+   * @param epochs Epochs when each garbage was registered.
+   * @param pos The position of the first garbage to be checked.
+   * @param end_pos The position next to the last garbage in the list.
+   * @param protected_epoch A protected epoch.
+   * @return The position of the first protected garbage (`end_pos` if all the
+   * garbage can be released).
+   * @note The epochs in each list are monotonically non-decreasing.
+   */
+  static auto
+  FindProtectedPos(  //
+      const size_t *epochs,
+      const size_t pos,
+      const size_t end_pos,
+      const size_t protected_epoch)  //
+      -> size_t
+  {
+    if (pos >= end_pos || epochs[end_pos - 1] < protected_epoch) return end_pos;
+    return std::lower_bound(&(epochs[pos]), &(epochs[end_pos - 1]), protected_epoch) - epochs;
+  }
+
+  /**
+   * @brief Remove a drained list from the head of garbage lists.
+   *
+   * @param[in,out] list_addr The address of the pointer of the drained list.
+   * @param[in,out] stats Statistics counters of a cleaner thread.
+   */
+  static void
+  RemoveHead(  //
+      VolatileGarbageList **list_addr,
+      ListStats *stats)
+  {
+    auto *list = *list_addr;
+    *list_addr = list->gc_next_;
+    delete list;
+    ListStats::Add(stats->removed_lists);
+  }
+
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief The position of the first reusable page.
+  std::atomic_size_t begin_pos_{0};
+
+  /// @brief The position of the first not destructed page.
+  std::atomic_size_t mid_pos_{0};
+
+  /// @brief Epochs when each garbage is registered.
+  size_t epochs_[kBufferSize]{};
+
+  /// @brief Garbage pointers.
+  void *garbages_[kBufferSize]{};
+
+  /// @brief The position of the last garbage.
+  std::atomic_size_t end_pos_{0};
+
+  /// @brief The next garbage list address for client threads.
+  std::atomic_uintptr_t next_{};
+
+  /// @brief The next garbage list address for cleaner threads.
+  VolatileGarbageList *gc_next_{nullptr};
+};
+
+}  // namespace dbgroup::pmem::memory::component
+
+#endif  // PMEM_MEMORY_COMPONENT_VOLATILE_GARBAGE_LIST_HPP
@@ -0,0 +1,311 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PMEM_MEMORY_COMPONENT_VOLATILE_LIST_HEADER_HPP
+#define PMEM_MEMORY_COMPONENT_VOLATILE_LIST_HEADER_HPP
+
+// C++ standard libraries
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+
+// external sources
+#include "thread/id_manager.hpp"
+
+// local sources
+#include "pmem/memory/component/list_stats.hpp"
+#include "pmem/memory/component/owner_word.hpp"
+#include "pmem/memory/component/volatile_garbage_list.hpp"
+#include "pmem/memory/utility.hpp"
+
+namespace dbgroup::pmem::memory::component
+{
+/**
+ * @brief A class for representing a header of garbage lists only in DRAM.
+ *
+ * This class is used for targets whose `kOnPMEM` is false. Garbage is given as
+ * plain pointers allocated by `::operator new` (e.g., `new T`), and it is
+ * released without any PMDK calls and persistence.
+ *
+ * @tparam Target a target class of garbage collection.
+ */
+template <class Target>
+class alignas(kCacheLineSize) VolatileListHeader
+{
+  /*############################################################################
+   * Type aliases
+   *##########################################################################*/
+
+  using T = typename Target::T;
+  using IDManager = ::dbgroup::thread::IDManager;
+
+ public:
+  /*############################################################################
+   * Public constructors and assignment operators
+   *##########################################################################*/
+
+  /**
+   * @brief Construct a new VolatileListHeader object.
+   *
+   */
+  constexpr VolatileListHeader() = default;
+
+  VolatileListHeader(const VolatileListHeader &) = delete;
+  VolatileListHeader(VolatileListHeader &&) = delete;
+
+  auto operator=(const VolatileListHeader &) -> VolatileListHeader & = delete;
+  auto operator=(VolatileListHeader &&) -> VolatileListHeader & = delete;
+
+  /*############################################################################
+   * Public destructors
+   *##########################################################################*/
+
+  /**
+   * @brief Destroy the VolatileListHeader object.
+   *
+   * If the list contains unreleased garbage, the destructor will forcibly release it.
+   */
+  ~VolatileListHeader()
+  {
+    if (gc_head_ != nullptr) {
+      constexpr auto kMaxEpoch = std::numeric_limits<size_t>::max();
+      VolatileGarbageList::Clear<T>(&gc_head_, kMaxEpoch, &gc_stats_);
+      delete gc_head_;
+    }
+  }
+
+  /*############################################################################
+   * Public utilities for clients
+   *##########################################################################*/
+
+  /**
+   * @brief Add a new garbage instance.
+   *
+   * @param epoch An epoch value when a garbage is added.
+   * @param garbage a pointer to a target garbage.
+   * @return The total number of garbage added by the current thread.
+   */
+  auto
+  AddGarbage(  //
+      const size_t epoch,
+      void *garbage)  //
+      -> size_t
+  {
+    AssignCurrentThreadIfNeeded();
+    VolatileGarbageList::AddGarbage(&cli_tail_, epoch, garbage, &cli_stats_);
+    ListStats::Add(cli_stats_.added);
+    return ++garbage_cnt_;
+  }
+
+  /**
+   * @brief Reuse a released memory page if it exists in the list.
+   *
+   * @return A reusable page if exist (nullptr otherwise).
+   */
+  auto
+  GetPageIfPossible()  //
+      -> void *
+  {
+    AssignCurrentThreadIfNeeded();
+    auto *page = VolatileGarbageList::ReusePage(&cli_head_);
+    if (page == nullptr) {
+      ListStats::Add(cli_stats_.reuse_misses);
+    } else {
+      ListStats::Add(cli_stats_.reused);
+    }
+    return page;
+  }
+
+  /**
+   * @return The number of garbage lists that this header holds.
+   * @note This function may be called only by the owner thread.
+   */
+  [[nodiscard]] auto
+  GetLiveListNum() const  //
+      -> size_t
+  {
+    const auto created = cli_stats_.created_lists.load(kRelaxed);
+    const auto removed = gc_stats_.removed_lists.load(kRelaxed);
+    return created > removed ? created - removed : 0;
+  }
+
+  /**
+   * @return Statistics counters updated by client threads.
+   */
+  [[nodiscard]] auto
+  GetClientStats() const  //
+      -> const ListStats &
+  {
+    return cli_stats_;
+  }
+
+  /**
+   * @return Statistics counters updated by cleaner threads.
+   */
+  [[nodiscard]] auto
+  GetGCStats() const  //
+      -> const ListStats &
+  {
+    return gc_stats_;
+  }
+
+  /*############################################################################
+   * Public utilities for garbage collection
+   *##########################################################################*/
+
+  /**
+   * @param active_word a word of a bitmap for tracking active lists.
+   * @param active_mask a bit mask that represents this list in the word.
+   * @note This list sets its bit in the word while it has garbage lists.
+   */
+  void
+  SetActiveWord(  //
+      std::atomic_uint64_t *active_word,
+      const uint64_t active_mask)
+  {
+    active_word_ = active_word;
+    active_mask_ = active_mask;
+  }
+
+  /**
+   * @brief Release registered garbage if possible.
+   *
+   * @param protected_epoch an epoch value to check whether garbage can be freed.
+   * @retval true if this list may still have garbage to be collected.
+   * @retval false otherwise.
+   */
+  auto
+  ClearGarbage(                      //
+      const size_t protected_epoch)  //
+      -> bool
+  {
+    std::unique_lock guard{owner_, std::defer_lock};
+    if (!guard.try_lock()) return true;
+    if (gc_head_ == nullptr) return false;
+
+    // destruct or release garbages
+    bool has_garbage{};
+    if constexpr (!Target::kReusePages) {
+      has_garbage = VolatileGarbageList::Clear<T>(&gc_head_, protected_epoch, &gc_stats_);
+    } else {
+      if (!heartbeat_.expired()) {
+        return VolatileGarbageList::Destruct<T>(&gc_head_, protected_epoch, &gc_stats_);
+      }
+      has_garbage = VolatileGarbageList::Clear<T>(&gc_head_, protected_epoch, &gc_stats_);
+      cli_head_ = gc_head_;
+    }
+    if (!heartbeat_.expired() || !gc_head_->Empty()) return has_garbage;
+
+    delete gc_head_;
+    gc_head_ = nullptr;
+    cli_tail_ = nullptr;
+    cli_head_ = nullptr;
+    ListStats::Add(gc_stats_.removed_lists);
+    if (active_word_ != nullptr) {
+      active_word_->fetch_and(~active_mask_, kRelaxed);
+    }
+    return false;
+  }
+
+  /**
+   * @brief Release all the garbage in this list regardless of epochs.
+   *
+   * @note This function must not be called concurrently with client threads.
+   */
+  void
+  Drain()
+  {
+    std::lock_guard guard{owner_};
+    if (gc_head_ == nullptr) return;
+
+    constexpr auto kMaxEpoch = std::numeric_limits<size_t>::max();
+    VolatileGarbageList::Clear<T>(&gc_head_, kMaxEpoch, &gc_stats_);
+  }
+
+ private:
+  /*############################################################################
+   * Internal utility functions
+   *##########################################################################*/
+
+  /**
+   * @brief Assign this list to the current thread.
+   *
+   */
+  void
+  AssignCurrentThreadIfNeeded()
+  {
+    if (owner_.IsOwnedByCurrentThread()) return;
+
+    std::unique_lock guard{owner_};
+    if (gc_head_ == nullptr) {
+      gc_head_ = new VolatileGarbageList{};
+      ListStats::Add(cli_stats_.created_lists);
+      cli_tail_ = gc_head_;
+      if constexpr (Target::kReusePages) {
+        cli_head_ = cli_tail_;
+      }
+      if (active_word_ != nullptr) {
+        active_word_->fetch_or(active_mask_, kRelaxed);
+      }
+    }
+    heartbeat_ = IDManager::GetHeartBeat();
+    guard.release();
+    owner_.UnlockAsOwner();  // publish the token of the current thread
+  }
+
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  /// @brief A flag for indicating the corresponding thread has exited (only
+  /// accessed with the lock).
+  std::weak_ptr<size_t> heartbeat_{};
+
+  /// @brief A garbage list that has destructed pages.
+  VolatileGarbageList *cli_head_{nullptr};
+
+  /// @brief A garbage list that has free space for new garbages.
+  VolatileGarbageList *cli_tail_{nullptr};
+
+  /// @brief The number of garbage added by client threads.
+  size_t garbage_cnt_{0};
+
+  /// @brief A word of a bitmap for tracking lists that have garbage.
+  std::atomic_uint64_t *active_word_{nullptr};
+
+  /// @brief A bit mask that represents this list in the bitmap.
+  uint64_t active_mask_{0};
+
+  /// @brief The owner thread of this list and a lock for modifying buffer
+  /// pointers.
+  OwnerWord owner_{};
+
+  /// @brief The head of garbage lists.
+  VolatileGarbageList *gc_head_{nullptr};
+
+  /// @brief Statistics counters updated by client threads.
+  ListStats cli_stats_{};
+
+  /// @brief Statistics counters updated by cleaner threads.
+  ListStats gc_stats_{};
+};
+
+}  // namespace dbgroup::pmem::memory::component
+
+#endif  // PMEM_MEMORY_COMPONENT_VOLATILE_LIST_HEADER_HPP
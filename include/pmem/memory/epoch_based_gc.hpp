@@ -21,15 +21,23 @@
 #include <sys/stat.h>
 
 // C++ standard libraries
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <initializer_list>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
 #include <thread>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -40,6 +48,9 @@
 
 // local sources
 #include "pmem/memory/component/list_header.hpp"
+#include "pmem/memory/component/reserved_intervals.hpp"
+#include "pmem/memory/component/shared_page_pool.hpp"
+#include "pmem/memory/component/volatile_list_header.hpp"
 #include "pmem/memory/utility.hpp"
 
 namespace dbgroup::pmem::memory
@@ -58,11 +69,265 @@ class EpochBasedGC
 
   using Clock_t = ::std::chrono::high_resolution_clock;
   using TLSFields = component::TLSFields;
+  using ListHeads = component::ListHeads;
+  using SpareLists = component::SpareLists;
+  using ReservedIntervals = component::ReservedIntervals;
 
   template <class Target>
-  using GarbageList = component::ListHeader<Target>;
+  using GarbageList = std::conditional_t<Target::kOnPMEM,
+                                         component::ListHeader<Target>,
+                                         component::VolatileListHeader<Target>>;
+
+  template <class Target>
+  using ListChunks = std::unique_ptr<std::unique_ptr<GarbageList<Target>[]>[]>;
 
  public:
+  /*############################################################################
+   * Public classes
+   *##########################################################################*/
+
+  /**
+   * @brief Statistics of crash recovery in construction.
+   *
+   */
+  struct RecoveryInfo {
+    /// @brief The number of recovered garbage lists (i.e., thread-local heads).
+    size_t list_num{0};
+
+    /// @brief The number of released garbage.
+    size_t garbage_num{0};
+
+    /// @brief The elapsed time for recovery.
+    std::chrono::microseconds time{0};
+  };
+
+  /**
+   * @brief A snapshot of statistics for each GC target.
+   *
+   */
+  struct Stats {
+    /// @brief The number of added garbage.
+    size_t added{0};
+
+    /// @brief The number of destructed garbage.
+    size_t destructed{0};
+
+    /// @brief The number of released garbage.
+    size_t released{0};
+
+    /// @brief The number of reused pages.
+    size_t reused{0};
+
+    /// @brief The number of `GetPageIfPossible` calls without reusable pages.
+    size_t reuse_misses{0};
+
+    /// @brief The number of garbage lists (i.e., `GarbageListInPMEM` blocks)
+    /// held by thread-local headers.
+    size_t live_lists{0};
+
+    /// @brief The current global epoch.
+    size_t current_epoch{0};
+
+    /// @brief The minimum epoch protected by any thread.
+    size_t min_epoch{0};
+
+    /// @brief The number of `pmem_persist` calls.
+    size_t persist_num{0};
+
+    /// @brief The number of PMDK free operations (including deferred ones).
+    size_t free_num{0};
+  };
+
+  /**
+   * @brief A handle of the garbage lists assigned to the current thread.
+   *
+   * A handle caches the positions of thread-local lists, and so functions that
+   * receive a handle skip the lookup of thread IDs and the check of list owners.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @note A handle may be used only by the thread that has created it.
+   */
+  template <class Target>
+  class ThreadHandle
+  {
+    friend class EpochBasedGC;
+
+    /// @brief The list of the smallest size class in the current thread.
+    GarbageList<Target> *lists_{nullptr};
+
+    /// @brief The nesting depth of reentrant guards in the current thread.
+    size_t *depth_{nullptr};
+  };
+
+  /**
+   * @brief A guard instance for nested scopes in the same thread.
+   *
+   * Only the outermost guard in each thread enters the epoch manager, and inner
+   * ones only update the nesting depth.
+   */
+  class ReentrantGuard
+  {
+   public:
+    /*##########################################################################
+     * Public constructors and assignment operators
+     *########################################################################*/
+
+    /**
+     * @brief Construct a new instance.
+     *
+     * @param epoch_manager An epoch manager for protecting garbage.
+     * @param depth The nesting depth of guards in the current thread.
+     */
+    ReentrantGuard(  //
+        ::dbgroup::thread::EpochManager &epoch_manager,
+        size_t *depth)
+        : depth_{depth}
+    {
+      if ((*depth_)++ == 0) {
+        guard_.emplace(epoch_manager.CreateEpochGuard());
+      }
+    }
+
+    ReentrantGuard(const ReentrantGuard &) = delete;
+    ReentrantGuard(ReentrantGuard &&) = delete;
+
+    auto operator=(const ReentrantGuard &) -> ReentrantGuard & = delete;
+    auto operator=(ReentrantGuard &&) -> ReentrantGuard & = delete;
+
+    /*##########################################################################
+     * Public destructors
+     *########################################################################*/
+
+    /**
+     * @brief Destroy the instance.
+     *
+     * If this guard is the outermost one, the current thread leaves the epoch.
+     */
+    ~ReentrantGuard() { --(*depth_); }
+
+   private:
+    /*##########################################################################
+     * Internal member variables
+     *########################################################################*/
+
+    /// @brief The nesting depth of guards in the current thread.
+    size_t *depth_{nullptr};
+
+    /// @brief An epoch guard held only by the outermost guard.
+    std::optional<::dbgroup::thread::EpochGuard> guard_{};
+  };
+
+  /**
+   * @brief A guard instance that reserves an interval of epochs.
+   *
+   * Unlike epoch guards, this guard does not protect all the garbage retired
+   * after its entry. For interval-based targets, it only protects garbage whose
+   * lifetime (i.e., from its birth epoch to its retire epoch) overlaps the
+   * reserved interval, and so a stalled reader cannot hold back the garbage
+   * allocated after its last read. The interval is extended by `Read`, and so
+   * shared pointers must be loaded via `Read` while holding this guard. A guard
+   * nested in the same thread shares the interval of the outermost one.
+   */
+  class IntervalGuard
+  {
+   public:
+    /*##########################################################################
+     * Public constructors and assignment operators
+     *########################################################################*/
+
+    /**
+     * @brief Construct a new instance.
+     *
+     * @param epoch_manager An epoch manager for reading the current epoch.
+     * @param lower The lower bound of the interval of the current thread.
+     * @param upper The upper bound of the interval of the current thread.
+     */
+    IntervalGuard(  //
+        ::dbgroup::thread::EpochManager &epoch_manager,
+        std::atomic_size_t *lower,
+        std::atomic_size_t *upper)
+        : epoch_manager_{&epoch_manager},
+          lower_{lower},
+          upper_{upper},
+          nested_{lower->load(std::memory_order_relaxed) != kNoReservation}
+    {
+      if (nested_) return;  // the outer guard has already reserved the interval
+
+      auto epoch = epoch_manager_->GetCurrentEpoch();
+      while (true) {
+        lower_->store(epoch);
+        upper_->store(epoch);
+        const auto cur = epoch_manager_->GetCurrentEpoch();
+        if (cur == epoch) break;
+        epoch = cur;
+      }
+    }
+
+    IntervalGuard(const IntervalGuard &) = delete;
+    IntervalGuard(IntervalGuard &&) = delete;
+
+    auto operator=(const IntervalGuard &) -> IntervalGuard & = delete;
+    auto operator=(IntervalGuard &&) -> IntervalGuard & = delete;
+
+    /*##########################################################################
+     * Public destructors
+     *########################################################################*/
+
+    /**
+     * @brief Destroy the instance.
+     *
+     * The reserved interval is released for cleaner threads unless this guard
+     * is nested in another one.
+     */
+    ~IntervalGuard()
+    {
+      if (nested_) return;
+      lower_->store(kNoReservation, std::memory_order_release);
+    }
+
+    /*##########################################################################
+     * Public utilities
+     *########################################################################*/
+
+    /**
+     * @brief Load a shared pointer and extend the interval to cover it.
+     *
+     * @tparam Func A type of a loading procedure.
+     * @param load A procedure that loads a shared pointer.
+     * @return The loaded value that is protected until this guard is released.
+     */
+    template <class Func>
+    auto
+    Read(                   //
+        Func &&load) const  //
+        -> decltype(load())
+    {
+      while (true) {
+        auto &&val = load();
+        const auto epoch = epoch_manager_->GetCurrentEpoch();
+        if (epoch == upper_->load(std::memory_order_relaxed)) return val;
+        upper_->store(epoch);
+      }
+    }
+
+   private:
+    /*##########################################################################
+     * Internal member variables
+     *########################################################################*/
+
+    /// @brief An epoch manager for reading the current epoch.
+    ::dbgroup::thread::EpochManager *epoch_manager_{nullptr};
+
+    /// @brief The lower bound of the interval of the current thread.
+    std::atomic_size_t *lower_{nullptr};
+
+    /// @brief The upper bound of the interval of the current thread.
+    std::atomic_size_t *upper_{nullptr};
+
+    /// @brief A flag for guards nested in another interval guard.
+    bool nested_{false};
+  };
+
   /*############################################################################
    * Public constructors and assignment operators
    *##########################################################################*/
@@ -75,29 +340,157 @@ class EpochBasedGC
    * @param layout_name The layout name.
    * @param gc_interval_micro_sec The duration of interval for GC.
    * @param gc_thread_num The maximum number of threads to perform GC.
+   * @param gc_watermark The number of garbage added by each thread to trigger
+   * GC (zero means that GC is triggered only by a fixed interval).
+   * @param recover_in_background A flag for releasing garbage lists left by
+   * a machine failure in the background.
+   * @note If the pool has garbage lists left by a machine failure, the
+   * constructor releases them with `gc_thread_num` threads in parallel. The
+   * result can be checked by `GetRecoveryInfo`.
+   * @note If `recover_in_background` is true, the constructor only detaches
+   * the left garbage lists from thread-local fields and returns immediately.
+   * Background threads release the detached lists, and `WaitForRecovery` can
+   * be used to wait for the completion.
+   * @note If `gc_watermark` is positive, GC runs in an adaptive mode: each
+   * thread wakes up GC when it adds every `gc_watermark` garbage, and the GC
+   * interval is exponentially backed off while there is no garbage.
    */
   explicit EpochBasedGC(  //
       const std::string &pmem_path,
       const size_t gc_size = PMEMOBJ_MIN_POOL * 2,  // about 1M garbage instances
       const std::string &layout_name = "gc_on_pmem",
       const size_t gc_interval_micro_sec = kDefaultGCTime,
-      const size_t gc_thread_num = kDefaultGCThreadNum)
-      : gc_interval_{gc_interval_micro_sec}, gc_thread_num_{gc_thread_num}
+      const size_t gc_thread_num = kDefaultGCThreadNum,
+      const size_t gc_watermark = kDefaultGCWatermark,
+      const bool recover_in_background = false)
+      : EpochBasedGC{std::vector<std::string>{pmem_path},
+                     gc_size,
+                     layout_name,
+                     gc_interval_micro_sec,
+                     gc_thread_num,
+                     gc_watermark,
+                     recover_in_background}
+  {
+  }
+
+  /**
+   * @brief Construct a new instance in the NUMA-aware mode.
+   *
+   * Each thread uses garbage lists in the pool of its NUMA node, and cleaner
+   * threads are pinned to each node and release the lists of the node first.
+   *
+   * @param pmem_paths The paths to pmemobj pools for GC, where the i-th path
+   * must be placed on the i-th NUMA node.
+   * @param gc_size The memory capacity of each pool for GC.
+   * @param layout_name The layout name.
+   * @param gc_interval_micro_sec The duration of interval for GC.
+   * @param gc_thread_num The maximum number of threads to perform GC.
+   * @param gc_watermark The number of garbage added by each thread to trigger
+   * GC (zero means that GC is triggered only by a fixed interval).
+   * @param recover_in_background A flag for releasing garbage lists left by
+   * a machine failure in the background.
+   * @throws std::runtime_error if any pool cannot be opened or was created by
+   * a version with another root layout.
+   * @note `gc_thread_num` is rounded up to the number of pools so that each
+   * node has at least one cleaner thread.
+   * @note The node of each thread is determined when it first accesses this
+   * instance, and so client threads should be pinned to CPUs.
+   */
+  explicit EpochBasedGC(  //
+      const std::vector<std::string> &pmem_paths,
+      const size_t gc_size = PMEMOBJ_MIN_POOL * 2,
+      const std::string &layout_name = "gc_on_pmem",
+      const size_t gc_interval_micro_sec = kDefaultGCTime,
+      const size_t gc_thread_num = kDefaultGCThreadNum,
+      const size_t gc_watermark = kDefaultGCWatermark,
+      const bool recover_in_background = false)
+      : gc_interval_{gc_interval_micro_sec},
+        gc_thread_num_{std::max(gc_thread_num, pmem_paths.size())},
+        gc_watermark_{gc_watermark},
+        node_num_{pmem_paths.size()}
   {
-    const auto *path = pmem_path.c_str();
+    if (node_num_ == 0) {
+      throw std::runtime_error{"at least one pmemobj pool is required for GC."};
+    }
+
     const auto *layout = layout_name.c_str();
-    pop_ = std::filesystem::exists(pmem_path)
-               ? pmemobj_open(path, layout)
-               : pmemobj_create(path, layout, gc_size + PMEMOBJ_MIN_POOL, S_IRUSR | S_IWUSR);
-    if (pop_ == nullptr) {
-      throw std::runtime_error{pmemobj_errormsg()};
+    for (const auto &pmem_path : pmem_paths) {
+      const auto *path = pmem_path.c_str();
+      auto *pop = std::filesystem::exists(pmem_path)
+                      ? pmemobj_open(path, layout)
+                      : pmemobj_create(path, layout, gc_size + PMEMOBJ_MIN_POOL, S_IRUSR | S_IWUSR);
+      if (pop == nullptr) {
+        const std::string msg{pmemobj_errormsg()};
+        for (auto *opened : pops_) {
+          pmemobj_close(opened);
+        }
+        throw std::runtime_error{msg};
+      }
+
+      // the root holds directories of thread-local fields, shared page pools,
+      // size classes, detached lists for background recovery, and spare lists
+      auto &&root = pmemobj_root(pop, kRootSize);
+      pops_.emplace_back(pop);
+      roots_.emplace_back(reinterpret_cast<PMEMoid *>(pmemobj_direct(root)));
+      if (!CheckLayoutVersion(roots_.back(), pmemobj_root_size(pop))) {
+        for (auto *opened : pops_) {
+          pmemobj_close(opened);
+        }
+        throw std::runtime_error{"the pool for GC was created by an incompatible version."};
+      }
     }
+    Initialize(recover_in_background);
+  }
 
-    auto &&root = pmemobj_root(pop_, sizeof(PMEMoid) * (sizeof...(GCTargets) + 1));
-    root_ = reinterpret_cast<PMEMoid *>(pmemobj_direct(root));
+  /**
+   * @brief Construct a new instance in an existing pmemobj pool.
+   *
+   * Thread-local fields and garbage lists are allocated in the given pool, and
+   * so GC shares the allocator and capacity of the pool with application data
+   * instead of mapping another pool.
+   *
+   * @param pop A pmemobj pool for GC (e.g., a pool for application data).
+   * @param gc_root A PMEMoid in the pool to hold the root region of GC.
+   * @param gc_interval_micro_sec The duration of interval for GC.
+   * @param gc_thread_num The maximum number of threads to perform GC.
+   * @param gc_watermark The number of garbage added by each thread to trigger
+   * GC (zero means that GC is triggered only by a fixed interval).
+   * @param recover_in_background A flag for releasing garbage lists left by
+   * a machine failure in the background.
+   * @throws std::runtime_error if `gc_root` is not in the given pool or has
+   * a root region of another layout version.
+   * @note If `gc_root` is NULL, the constructor allocates a root region to it.
+   * Otherwise, the constructor recovers garbage lists from the region, and so
+   * `gc_root` must be kept across restarts.
+   * @note The destructor does not close the given pool.
+   */
+  EpochBasedGC(  //
+      PMEMobjpool *pop,
+      PMEMoid *gc_root,
+      const size_t gc_interval_micro_sec = kDefaultGCTime,
+      const size_t gc_thread_num = kDefaultGCThreadNum,
+      const size_t gc_watermark = kDefaultGCWatermark,
+      const bool recover_in_background = false)
+      : gc_interval_{gc_interval_micro_sec},
+        gc_thread_num_{std::max<size_t>(gc_thread_num, 1)},
+        gc_watermark_{gc_watermark},
+        node_num_{1},
+        owns_pools_{false}
+  {
+    if (pop == nullptr || gc_root == nullptr || pmemobj_pool_by_ptr(gc_root) != pop) {
+      throw std::runtime_error{"the root of GC must be in the given pmemobj pool."};
+    }
 
-    InitializeGarbageLists<DefaultTarget, GCTargets...>();
-    cleaner_threads_.reserve(gc_thread_num_);
+    if (OID_IS_NULL(*gc_root)) {
+      Zalloc(pop, gc_root, kRootSize);
+    }
+    auto *root = reinterpret_cast<PMEMoid *>(pmemobj_direct(*gc_root));
+    if (!CheckLayoutVersion(root, pmemobj_alloc_usable_size(*gc_root))) {
+      throw std::runtime_error{"the root of GC was created by an incompatible version."};
+    }
+    pops_.emplace_back(pop);
+    roots_.emplace_back(root);
+    Initialize(recover_in_background);
   }
 
   EpochBasedGC(const EpochBasedGC &) = delete;
@@ -117,11 +510,21 @@ class EpochBasedGC
    */
   ~EpochBasedGC()
   {
-    // stop garbage collection
+    // wait for background recovery
+    if (recovery_thread_.joinable()) {
+      recovery_thread_.join();
+    }
+
+    // stop garbage collection and release lists even if GC has not started
     StopGC();
+    DestroyGarbageLists<DefaultTarget, GCTargets...>();
+    for (size_t chunk = 0; chunk < kWordNum; ++chunk) {
+      delete guard_chunks_[chunk].load(kAcquire);
+    }
 
-    if (pop_ != nullptr) {
-      pmemobj_close(pop_);
+    if (!owns_pools_) return;
+    for (auto *pop : pops_) {
+      pmemobj_close(pop);
     }
   }
 
@@ -142,6 +545,95 @@ class EpochBasedGC
     return epoch_manager_.CreateEpochGuard();
   }
 
+  /**
+   * @brief Create a guard instance that can be nested in the same thread.
+   *
+   * @return A guard instance to keep the current epoch.
+   * @note Only the outermost guard in each thread touches the epoch manager, and
+   * so this function is cheaper than `CreateEpochGuard` for nested scopes.
+   */
+  auto
+  CreateReentrantGuard()  //
+      -> ReentrantGuard
+  {
+    const auto id = ::dbgroup::thread::IDManager::GetThreadID();
+    return ReentrantGuard{epoch_manager_, &(GetGuardChunk(id).depths[id % kBitNum].depth)};
+  }
+
+  /**
+   * @brief Create a guard instance that can be nested in the same thread.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param handle A handle of the current thread.
+   * @return A guard instance to keep the current epoch.
+   */
+  template <class Target>
+  auto
+  CreateReentrantGuard(                    //
+      const ThreadHandle<Target> &handle)  //
+      -> ReentrantGuard
+  {
+    return ReentrantGuard{epoch_manager_, handle.depth_};
+  }
+
+  /**
+   * @brief Create a guard instance that reserves an interval of epochs.
+   *
+   * @return A guard instance to protect garbage alive in its interval.
+   * @note Guards can be nested in the same thread, and the outermost guard
+   * keeps the interval reserved until it is released. Garbage of targets
+   * without `kIntervalBased` is protected as well as epoch guards.
+   */
+  auto
+  CreateIntervalGuard()  //
+      -> IntervalGuard
+  {
+    const auto id = ::dbgroup::thread::IDManager::GetThreadID();
+    auto &slot = GetGuardChunk(id).intervals[id % kBitNum];
+    auto end = interval_end_.load(std::memory_order_relaxed);
+    while (end <= id && !interval_end_.compare_exchange_weak(end, id + 1)) {
+      // continue until the slot is visible to cleaner threads
+    }
+    return IntervalGuard{epoch_manager_, &(slot.lower), &(slot.upper)};
+  }
+
+  /**
+   * @return The current epoch to be recorded as the birth epoch of a page.
+   */
+  [[nodiscard]] auto
+  GetCurrentEpoch() const  //
+      -> size_t
+  {
+    return epoch_manager_.GetCurrentEpoch();
+  }
+
+  /**
+   * @brief Assign garbage lists to the current thread and get their handle.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @return A handle of the garbage lists of the current thread.
+   * @note This function prepares the lists of all the size classes, and the
+   * handle must not be used by other threads.
+   */
+  template <class Target = DefaultTarget>
+  auto
+  GetThreadHandle()  //
+      -> ThreadHandle<Target>
+  {
+    static_assert(Target::kOnPMEM, "DRAM-only targets do not support thread handles.");
+
+    auto *lists = GetGarbageList<Target>();
+    for (size_t cls = 0; cls < kClassNum<Target>; ++cls) {
+      lists[cls * kBitNum].AssignCurrentThreadIfNeeded();
+    }
+
+    const auto id = ::dbgroup::thread::IDManager::GetThreadID();
+    ThreadHandle<Target> handle{};
+    handle.lists_ = lists;
+    handle.depth_ = &(GetGuardChunk(id).depths[id % kBitNum].depth);
+    return handle;
+  }
+
   /*############################################################################
    * Public utility functions for persistent memory
    *##########################################################################*/
@@ -159,9 +651,90 @@ class EpochBasedGC
       const size_t i)  //
       -> PMEMoid *
   {
+    static_assert(Target::kOnPMEM, "DRAM-only targets do not have temporary fields.");
+
+    // temporary fields are shared among size classes
     return GetGarbageList<Target>()->GetTmpField(i);
   }
 
+  /**
+   * @brief Get the temporary field for memory allocation.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param handle A handle of the current thread.
+   * @param i The position of fields (0 <= i <= 12).
+   * @return The address of the specified temporary field.
+   */
+  template <class Target>
+  auto
+  GetTmpField(  //
+      const ThreadHandle<Target> &handle,
+      const size_t i)  //
+      -> PMEMoid *
+  {
+    return handle.lists_->template GetTmpField<true>(i);
+  }
+
+  /**
+   * @return Statistics of crash recovery in construction.
+   * @note If recovery runs in the background, this function waits for its
+   * completion.
+   */
+  [[nodiscard]] auto
+  GetRecoveryInfo()  //
+      -> RecoveryInfo
+  {
+    WaitForRecovery();
+    return recovery_info_;
+  }
+
+  /**
+   * @brief Create a snapshot of statistics for a given target.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @return The sum of counters in every node, thread, and size class.
+   * @note Counters are updated without synchronization, and so a snapshot may
+   * be slightly inconsistent (e.g., `live_lists` may be temporarily skewed).
+   * After `StopGC`, this function returns the final counters of the destroyed
+   * lists.
+   */
+  template <class Target = DefaultTarget>
+  [[nodiscard]] auto
+  GetStats()  //
+      -> Stats
+  {
+    auto stats = std::get<ListChunks<Target>>(garbage_lists_)  //
+                     ? SumListStats<Target>()
+                     : retired_stats_[GetTargetPos<Target>()];
+    stats.current_epoch = epoch_manager_.GetCurrentEpoch();
+    stats.min_epoch = epoch_manager_.GetMinEpoch();
+    return stats;
+  }
+
+  /**
+   * @retval true if garbage lists left by a machine failure have been released.
+   * @retval false otherwise.
+   */
+  [[nodiscard]] auto
+  IsRecovered() const  //
+      -> bool
+  {
+    return is_recovered_.load(kAcquire);
+  }
+
+  /**
+   * @brief Wait for background recovery to release all the left garbage.
+   *
+   */
+  void
+  WaitForRecovery()
+  {
+    if (IsRecovered()) return;
+
+    std::unique_lock lock{recovery_mtx_};
+    recovery_cv_.wait(lock, [this]() { return IsRecovered(); });
+  }
+
   /**
    * @brief Get the unreleased temporary fields of each thread.
    *
@@ -173,251 +746,1686 @@ class EpochBasedGC
   GetUnreleasedFields()  //
       -> std::vector<PMEMoid *>
   {
+    static_assert(Target::kOnPMEM, "DRAM-only targets do not have temporary fields.");
     return GetRemainingPMEMoids<Target, DefaultTarget, GCTargets...>();
   }
 
   /**
-   * @brief Add a new garbage instance.
+   * @brief Add a new garbage instance.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param oid A pointer to a target garbage.
+   */
+  template <class Target = DefaultTarget>
+  void
+  AddGarbage(  //
+      PMEMoid *oid)
+  {
+    static_assert(Target::kOnPMEM, "use AddGarbage(void *) for DRAM-only targets.");
+    AddGarbageToLists<Target, false>(GetGarbageList<Target>(), oid);
+  }
+
+  /**
+   * @brief Add a new garbage instance with the epoch when it was allocated.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param oid A pointer to a target garbage.
+   * @param birth_epoch An epoch when the garbage was allocated (i.e., a value of
+   * `GetCurrentEpoch` before the page was published).
+   * @note Garbage added without a birth epoch is regarded as being allocated at
+   * epoch zero, and so interval guards protect it as well as epoch guards.
+   */
+  template <class Target>
+  void
+  AddGarbage(  //
+      PMEMoid *oid,
+      const size_t birth_epoch)
+  {
+    static_assert(Target::kIntervalBased, "birth epochs are only for interval-based targets.");
+    AddGarbageToLists<Target, false>(GetGarbageList<Target>(), oid, birth_epoch);
+  }
+
+  /**
+   * @brief Add a new garbage instance.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param handle A handle of the current thread.
+   * @param oid A pointer to a target garbage.
+   */
+  template <class Target>
+  void
+  AddGarbage(  //
+      const ThreadHandle<Target> &handle,
+      PMEMoid *oid)
+  {
+    AddGarbageToLists<Target, true>(handle.lists_, oid);
+  }
+
+  /**
+   * @brief Add a new garbage instance in DRAM.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param garbage A pointer to a target garbage.
+   * @note The target must be a DRAM-only one (i.e., `kOnPMEM` is false), and
+   * garbage must be allocated by `::operator new` (e.g., `new T{}`).
+   */
+  template <class Target>
+  void
+  AddGarbage(  //
+      void *garbage)
+  {
+    static_assert(!Target::kOnPMEM, "use AddGarbage(PMEMoid *) for persistent targets.");
+
+    const auto epoch = epoch_manager_.GetCurrentEpoch();
+    auto *list = GetGarbageList<Target>();
+    const auto cnt = list->AddGarbage(epoch, garbage);
+    if (gc_watermark_ > 0 && cnt % gc_watermark_ == 0) {
+      RequestGC();
+    }
+    ApplyQuotas<Target>(list);
+  }
+
+  /**
+   * @brief Add new garbage instances at once.
+   *
+   * This function amortizes the cost of persistence by writing consecutive
+   * positions of a garbage list, flushing them at once, and nullifying the
+   * given PMEMoids with a single persist.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param oids Consecutive temporary fields that hold target garbage.
+   * @param n The number of target garbage.
+   * @note The given PMEMoids must be the temporary fields of the current thread
+   * (i.e., `oids` is `GetTmpField<Target>(i)` and `i + n <= kTmpFieldNum`).
+   * @note If a target has multiple size classes, each garbage is added to the
+   * list of its size class one by one.
+   */
+  template <class Target = DefaultTarget>
+  void
+  AddGarbages(  //
+      PMEMoid *oids,
+      const size_t n)
+  {
+    static_assert(Target::kOnPMEM, "DRAM-only targets do not have temporary fields.");
+    AddGarbagesToLists<Target, false>(GetGarbageList<Target>(), oids, n);
+  }
+
+  /**
+   * @brief Add new garbage instances at once.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param handle A handle of the current thread.
+   * @param oids Consecutive temporary fields that hold target garbage.
+   * @param n The number of target garbage.
+   */
+  template <class Target>
+  void
+  AddGarbages(  //
+      const ThreadHandle<Target> &handle,
+      PMEMoid *oids,
+      const size_t n)
+  {
+    AddGarbagesToLists<Target, true>(handle.lists_, oids, n);
+  }
+
+  /**
+   * @brief Reuse a released memory page if it exists.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param[out] out_oid The address to be stored a reusable page.
+   * @param size The desired size of a page.
+   * @note If a target has multiple size classes (i.e., `kPageSizes`), this
+   * function returns a page of the smallest class that can hold `size` bytes.
+   * If there is no such class, `out_oid` remains NULL.
+   */
+  template <class Target = DefaultTarget>
+  void
+  GetPageIfPossible(  //
+      PMEMoid *out_oid,
+      const size_t size = 0)
+  {
+    static_assert(Target::kOnPMEM, "use GetPageIfPossible() for DRAM-only targets.");
+    GetPageFromLists<Target, false>(GetGarbageList<Target>(), out_oid, size);
+  }
+
+  /**
+   * @brief Reuse a released memory page if it exists.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param handle A handle of the current thread.
+   * @param[out] out_oid The address to be stored a reusable page.
+   * @param size The desired size of a page.
+   */
+  template <class Target>
+  void
+  GetPageIfPossible(  //
+      const ThreadHandle<Target> &handle,
+      PMEMoid *out_oid,
+      const size_t size = 0)
+  {
+    GetPageFromLists<Target, true>(handle.lists_, out_oid, size);
+  }
+
+  /**
+   * @brief Allocate a page to a temporary field by reusing garbage if possible.
+   *
+   * If a target reuses pages, this function first tries to reuse a released
+   * page. Otherwise, it allocates a new page. If `kMagazineSize` is not zero,
+   * it publishes one of the pages reserved in bulk for the current thread, and
+   * so the PMDK allocator is not called for each page.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param pop A pmemobj pool for allocating a page.
+   * @param i The position of temporary fields (0 <= i <= 12).
+   * @param size The desired size of a page.
+   * @return The address of the temporary field that holds the page.
+   * @note The temporary field must be NULL in advance.
+   * @note Reserved pages are cancelled when this instance is destroyed, and so
+   * the given pool must be open until then.
+   */
+  template <class Target = DefaultTarget>
+  auto
+  Allocate(  //
+      PMEMobjpool *pop,
+      const size_t i,
+      const size_t size)  //
+      -> PMEMoid *
+  {
+    static_assert(Target::kOnPMEM, "DRAM-only targets do not have temporary fields.");
+    return AllocateOnLists<Target, false>(GetGarbageList<Target>(), pop, i, size);
+  }
+
+  /**
+   * @brief Allocate a page to a temporary field by reusing garbage if possible.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param handle A handle of the current thread.
+   * @param pop A pmemobj pool for allocating a page.
+   * @param i The position of temporary fields (0 <= i <= 12).
+   * @param size The desired size of a page.
+   * @return The address of the temporary field that holds the page.
+   */
+  template <class Target>
+  auto
+  Allocate(  //
+      const ThreadHandle<Target> &handle,
+      PMEMobjpool *pop,
+      const size_t i,
+      const size_t size)  //
+      -> PMEMoid *
+  {
+    return AllocateOnLists<Target, true>(handle.lists_, pop, i, size);
+  }
+
+  /**
+   * @brief Reuse a destructed page in DRAM if it exists.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @return A reusable page if exist (nullptr otherwise).
+   * @note The target must be a DRAM-only one (i.e., `kOnPMEM` is false).
+   */
+  template <class Target>
+  auto
+  GetPageIfPossible()  //
+      -> void *
+  {
+    static_assert(Target::kReusePages);
+    static_assert(!Target::kOnPMEM, "use GetPageIfPossible(PMEMoid *) for persistent targets.");
+    return GetGarbageList<Target>()->GetPageIfPossible();
+  }
+
+  /*############################################################################
+   * Public GC control functions
+   *##########################################################################*/
+
+  /**
+   * @brief Start garbage collection.
+   *
+   * @retval true if garbage collection has started.
+   * @retval false if garbage collection is already running.
+   */
+  auto
+  StartGC()  //
+      -> bool
+  {
+    if (gc_is_running_.load(std::memory_order_relaxed)) return false;
+
+    gc_is_running_.store(true, std::memory_order_relaxed);
+    gc_thread_ = std::thread{&EpochBasedGC::RunGC, this};
+    return true;
+  }
+
+  /**
+   * @brief Stop garbage collection.
+   *
+   * The remaining garbage is released by `gc_thread_num` threads in parallel.
+   * If `fast_shutdown` is true, garbage lists in persistent memory are left as
+   * they are, and the recovery procedure in the next construction releases the
+   * garbage (without destruction) instead.
+   *
+   * @param fast_shutdown A flag for leaving garbage for the next construction.
+   * @retval true if garbage collection has stopped.
+   * @retval false if garbage collection is not running.
+   */
+  auto
+  StopGC(                                 //
+      const bool fast_shutdown = false)  //
+      -> bool
+  {
+    if (!gc_is_running_.load(std::memory_order_relaxed)) return false;
+
+    {
+      std::lock_guard guard{gc_mtx_};
+      gc_is_running_.store(false, std::memory_order_relaxed);
+    }
+    gc_cv_.notify_all();
+    gc_thread_.join();
+    DestroyGarbageLists<DefaultTarget, GCTargets...>(fast_shutdown);
+    return true;
+  }
+
+ private:
+  /*############################################################################
+   * Internal constants
+   *##########################################################################*/
+
+  /// @brief The expected maximum number of threads.
+  static constexpr size_t kMaxThreadNum = ::dbgroup::thread::kMaxThreadNum;
+
+  /// @brief The number of bits in each word of bitmaps.
+  static constexpr size_t kBitNum = 64;
+
+  /// @brief The number of words in a bitmap for each target.
+  static constexpr size_t kWordNum = (kMaxThreadNum + kBitNum - 1) / kBitNum;
+
+  /// @brief The number of GC targets.
+  static constexpr size_t kTargetNum = sizeof...(GCTargets) + 1;
+
+  /// @brief A sentinel for indicating a thread does not reserve any interval.
+  static constexpr size_t kNoReservation = std::numeric_limits<size_t>::max();
+
+  /// @brief The number of PMEMoids in the root region of each pool.
+  static constexpr size_t kRootSlotNum = kTargetNum * 4 + 1;
+
+  /// @brief The size of the root region (PMEMoids and a layout version).
+  static constexpr size_t kRootSize = sizeof(PMEMoid) * kRootSlotNum + sizeof(uint64_t);
+
+  /// @brief The version of the root layout (i.e., chunked thread-local fields).
+  static constexpr uint64_t kLayoutVersion = 2;
+
+  /// @brief The number of size classes of each target.
+  template <class Target>
+  static constexpr size_t kClassNum = Target::kPageSizes.size();
+
+  /**
+   * @param sizes The sizes of size classes.
+   * @retval true if the given sizes are in strictly ascending order.
+   * @retval false otherwise.
+   */
+  template <size_t kNum>
+  static constexpr auto
+  IsAscending(  //
+      const std::array<size_t, kNum> &sizes)  //
+      -> bool
+  {
+    for (size_t i = 1; i < kNum; ++i) {
+      if (sizes[i - 1] >= sizes[i]) return false;
+    }
+    return true;
+  }
+
+  /// @brief The first position of each target in bitmaps of size classes.
+  static constexpr auto kClassOffsets = []() {
+    constexpr std::array<size_t, kTargetNum> kNums{kClassNum<DefaultTarget>,
+                                                   kClassNum<GCTargets>...};
+    std::array<size_t, kTargetNum + 1> offsets{};
+    for (size_t i = 0; i < kTargetNum; ++i) {
+      offsets[i + 1] = offsets[i] + kNums[i];
+    }
+    return offsets;
+  }();
+
+  /**
+   * @tparam Target A class for representing target garbage.
+   * @return The position of the target in a root region.
+   */
+  template <class Target>
+  static constexpr auto
+  GetTargetPos()  //
+      -> size_t
+  {
+    constexpr std::array<bool, kTargetNum> kIsTarget{std::is_same_v<Target, DefaultTarget>,
+                                                     std::is_same_v<Target, GCTargets>...};
+    size_t pos = 0;
+    while (pos < kTargetNum - 1 && !kIsTarget[pos]) {
+      ++pos;
+    }
+    return pos;
+  }
+
+  /// @brief The number of words in bitmaps of active lists for each node.
+  static constexpr size_t kBitmapSize = kClassOffsets[kTargetNum] * kWordNum;
+
+  /// @brief The positions of targets in descending order of their priorities.
+  static constexpr auto kPriorityOrder = []() {
+    constexpr std::array<size_t, kTargetNum> kPriorities{DefaultTarget::kGCPriority,
+                                                         GCTargets::kGCPriority...};
+    std::array<size_t, kTargetNum> order{};
+    for (size_t i = 0; i < kTargetNum; ++i) {
+      order[i] = i;
+    }
+    for (size_t i = 1; i < kTargetNum; ++i) {  // stable insertion sort
+      for (size_t j = i; j > 0 && kPriorities[order[j - 1]] < kPriorities[order[j]]; --j) {
+        const auto tmp = order[j];
+        order[j] = order[j - 1];
+        order[j - 1] = tmp;
+      }
+    }
+    return order;
+  }();
+
+  /// @brief The minimum interval between passes of cleaners for each target.
+  static constexpr std::array<std::chrono::microseconds, kTargetNum> kTargetIntervals{
+      std::chrono::microseconds{DefaultTarget::kGCIntervalMicroSec},
+      std::chrono::microseconds{GCTargets::kGCIntervalMicroSec}...};
+
+  /// @brief The maximum ratio of a backed-off interval to the default one.
+  static constexpr size_t kMaxBackoff = 64;
+
+  /// @brief The maximum number of forwarded epochs without progress for threads
+  /// that exceed their hard quotas.
+  static constexpr size_t kQuotaRetryNum = 16;
+
+  /// @brief The maximum number of garbage reclaimed by a thread in each quota check.
+  static constexpr size_t kQuotaReleaseNum = kBufferSize;
+
+  /*############################################################################
+   * Internal classes
+   *##########################################################################*/
+
+  /**
+   * @brief A range of thread IDs assigned to each cleaner.
+   *
+   */
+  struct alignas(kCacheLineSize) Shard {
+    /// @brief The next thread ID to be cleared in the current pass for each
+    /// target.
+    std::array<std::atomic_size_t, kTargetNum> pos{};
+
+    /// @brief The global epoch when the current pass started for each target.
+    std::array<std::atomic_size_t, kTargetNum> pass{};
+
+    /// @brief The NUMA node of this shard.
+    size_t node{};
+
+    /// @brief The first thread ID of this shard.
+    size_t begin{};
+
+    /// @brief The thread ID next to the last one of this shard.
+    size_t end{};
+  };
+
+  /**
+   * @brief The nesting depth of reentrant guards in each thread.
+   *
+   */
+  struct alignas(kCacheLineSize) GuardDepth {
+    /// @brief The number of live guards in the thread.
+    size_t depth{0};
+  };
+
+  /**
+   * @brief An interval of epochs reserved by an interval guard of each thread.
+   *
+   */
+  struct alignas(kCacheLineSize) IntervalSlot {
+    /// @brief The epoch when the guard was created.
+    std::atomic_size_t lower{kNoReservation};
+
+    /// @brief The epoch when the guard read a shared pointer last.
+    std::atomic_size_t upper{0};
+  };
+
+  /**
+   * @brief The states of reentrant and interval guards in a chunk of threads.
+   *
+   */
+  struct GuardChunk {
+    /// @brief The nesting depth of reentrant guards for each thread.
+    std::array<GuardDepth, kBitNum> depths{};
+
+    /// @brief The intervals reserved by interval guards for each thread.
+    std::array<IntervalSlot, kBitNum> intervals{};
+  };
+
+  /**
+   * @brief Garbage lists of a thread to be released for recovery.
+   *
+   */
+  struct RecoveryTask {
+    /// @brief The head pointer of target garbage lists.
+    PMEMoid *head{nullptr};
+
+    /// @brief A temporary field to swap head pointers.
+    PMEMoid *tmp_head{nullptr};
+
+    /// @brief Thread-local fields that have temporary fields.
+    TLSFields *tls{nullptr};
+
+    /// @brief Thread-local fields that may have PMEMoids reused from the lists.
+    std::vector<const TLSFields *> others{};
+
+    /// @brief The NUMA node of the pool that has the lists.
+    size_t node{0};
+
+    /// @brief A flag for indicating the lists are shared by multiple threads.
+    bool is_shared{false};
+  };
+
+  /*############################################################################
+   * Internal utilities for initialization and finalization
+   *##########################################################################*/
+
+  /**
+   * @brief Prepare garbage lists and cleaner threads in opened pools.
+   *
+   * @param recover_in_background A flag for releasing garbage lists left by
+   * a machine failure in the background.
+   */
+  void
+  Initialize(  //
+      const bool recover_in_background)
+  {
+    shared_pools_.resize(node_num_ * kTargetNum);
+    active_lists_.reset(new std::atomic_uint64_t[node_num_ * kBitmapSize]{});
+    bound_chunks_.reset(new std::atomic_bool[node_num_ * kTargetNum * kWordNum]{});
+
+    ReleaseDetachedLists();
+    std::vector<RecoveryTask> tasks{};
+    InitializeGarbageLists<DefaultTarget, GCTargets...>(tasks);
+    if (recover_in_background && !tasks.empty()) {
+      DetachGarbageLists(tasks);
+      recovery_thread_ = std::thread{[this]() {
+        RecoverGarbageLists(recovery_tasks_);
+        ReleaseDetachedLists();
+        recovery_tasks_.clear();
+
+        std::lock_guard guard{recovery_mtx_};
+        is_recovered_.store(true, kRelease);
+        recovery_cv_.notify_all();
+      }};
+    } else {
+      RecoverGarbageLists(tasks);
+      is_recovered_.store(true, kRelease);
+    }
+    cleaner_threads_.reserve(gc_thread_num_);
+
+    // partition thread IDs of each node for its cleaner threads
+    shards_.reset(new Shard[gc_thread_num_]);
+    for (size_t node = 0; node < node_num_; ++node) {
+      const auto begin = gc_thread_num_ * node / node_num_;
+      const auto num = gc_thread_num_ * (node + 1) / node_num_ - begin;
+      for (size_t i = 0; i < num; ++i) {
+        auto &shard = shards_[begin + i];
+        shard.node = node;
+        shard.begin = kMaxThreadNum * i / num;
+        shard.end = kMaxThreadNum * (i + 1) / num;
+        for (auto &&pos : shard.pos) {
+          pos.store(shard.end, kRelaxed);
+        }
+        for (auto &&pass : shard.pass) {
+          pass.store(std::numeric_limits<size_t>::max(), kRelaxed);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Check the layout version of a root region.
+   *
+   * If the region has never been used, this function records the current
+   * version in it.
+   *
+   * @param root The root region of GC.
+   * @param size The usable size of the root region.
+   * @retval true if the region can be used with the current layout.
+   * @retval false if the region was created by an incompatible version.
+   */
+  static auto
+  CheckLayoutVersion(  //
+      PMEMoid *root,
+      const size_t size)  //
+      -> bool
+  {
+    if (size < kRootSize) return false;
+
+    auto *version = reinterpret_cast<uint64_t *>(&(root[kRootSlotNum]));
+    if (*version == kLayoutVersion) return true;
+    if (*version != 0) return false;
+    for (size_t i = 0; i < kRootSlotNum; ++i) {
+      if (!OID_IS_NULL(root[i])) return false;  // written by an older version
+    }
+    *version = kLayoutVersion;
+    Persist(version, sizeof(uint64_t));
+    return true;
+  }
+
+  /**
+   * @brief A dummy function for creating type aliases.
+   *
+   */
+  template <class Target, class... Tails>
+  static auto
+  ConvToTuple()
+  {
+    if constexpr (sizeof...(Tails) > 0) {
+      return std::tuple_cat(std::tuple<ListChunks<Target>>{}, ConvToTuple<Tails...>());
+    } else {
+      return std::tuple<ListChunks<Target>>{};
+    }
+  }
+
+  /**
+   * @param addr The begin address.
+   * @return The head of thread local regions.
+   */
+  static constexpr auto
+  GetTLSHead(            //
+      const void *addr)  //
+      -> TLSFields *
+  {
+    constexpr uintptr_t kMask = kPMEMLineSize - 1;
+    auto ptr = reinterpret_cast<uintptr_t>(addr);
+    if ((ptr & kMask) > 0) {
+      // move the address to the Intel Optane alignment
+      ptr = (ptr & ~kMask) + kPMEMLineSize;
+    }
+    return reinterpret_cast<TLSFields *>(ptr);
+  }
+
+  /**
+   * @brief Create the space for garbage lists for all the target garbage.
+   *
+   * @tparam Target The current class in garbage targets.
+   * @tparam Tails The remaining classes in garbage targets.
+   * @param[out] tasks Garbage lists to be released for recovery.
+   * @param pos The position of the current target in a root region.
+   */
+  template <class Target, class... Tails>
+  void
+  InitializeGarbageLists(  //
+      std::vector<RecoveryTask> &tasks,
+      const size_t pos = 0)
+  {
+    constexpr auto kClasses = kClassNum<Target>;
+    static_assert(kClasses > 0);
+    static_assert(IsAscending(Target::kPageSizes), "page sizes must be in ascending order.");
+    static_assert(kClasses == 1 || Target::kSharedPoolCapacity == 0,
+                  "shared page pools do not support multiple size classes.");
+    static_assert(!Target::kIntervalBased
+                      || (Target::kOnPMEM && !Target::kReusePages && !Target::kReleaseInBatch),
+                  "interval-based targets must be persistent ones that release pages one by one.");
+
+    // lists are allocated in chunks when threads use them first
+    std::get<ListChunks<Target>>(garbage_lists_)
+        .reset(new std::unique_ptr<GarbageList<Target>[]>[node_num_ * kWordNum]);
+    for (size_t node = 0; node < node_num_; ++node) {
+      if constexpr (Target::kOnPMEM) {
+        InitializeGarbageListsOnNode<Target>(tasks, pos, node);
+      } else {
+        // DRAM-only lists do not use root regions in pools
+        static_assert(kClasses == 1, "DRAM-only targets do not support size classes.");
+        static_assert(Target::kSharedPoolCapacity == 0,
+                      "DRAM-only targets do not support shared page pools.");
+      }
+    }
+
+    if constexpr (sizeof...(Tails) > 0) {
+      InitializeGarbageLists<Tails...>(tasks, pos + 1);
+    }
+  }
+
+  /**
+   * @brief Prepare garbage lists of a target in the pool of a given node.
+   *
+   * @tparam Target The current class in garbage targets.
+   * @param[out] tasks Garbage lists to be released for recovery.
+   * @param pos The position of the current target in a root region.
+   * @param node The NUMA node of the pool.
+   */
+  template <class Target>
+  void
+  InitializeGarbageListsOnNode(  //
+      std::vector<RecoveryTask> &tasks,
+      const size_t pos,
+      const size_t node)
+  {
+    constexpr auto kClasses = kClassNum<Target>;
+
+    auto *pop = pops_[node];
+    auto *root = roots_[node];
+
+    // thread-local fields are allocated in chunks when threads use them first
+    auto *dir_oid = &(root[pos]);
+    if (OID_IS_NULL(*dir_oid)) {  // the first call
+      Zalloc(pop, dir_oid, sizeof(PMEMoid) * kWordNum);
+    }
+    for (size_t chunk = 0; chunk < kWordNum; ++chunk) {
+      auto *tls_fields = GetTLSChunk(node, pos, chunk);
+      if (tls_fields == nullptr) continue;
+      for (size_t i = 0; i < kBitNum; ++i) {
+        auto *tls_field = &(tls_fields[i]);
+        if (!OID_IS_NULL(tls_field->head)) {  // need recovery
+          tasks.emplace_back(RecoveryTask{&(tls_field->head), &(tls_field->tmp_head), tls_field,
+                                          {}, node});
+        }
+      }
+    }
+
+    // prepare additional list heads for size classes
+    auto *heads_oid = &(root[kTargetNum * 2 + pos]);
+    if constexpr (kClasses > 1) {
+      if (OID_IS_NULL(*heads_oid)) {  // the first call
+        Zalloc(pop, heads_oid, sizeof(ListHeads) * kMaxThreadNum * (kClasses - 1));
+      }
+    }
+    if (!OID_IS_NULL(*heads_oid)) {
+      const auto heads_num = pmemobj_alloc_usable_size(*heads_oid) / sizeof(ListHeads);
+      auto *heads = reinterpret_cast<ListHeads *>(pmemobj_direct(*heads_oid));
+      for (size_t j = 0; j < heads_num; ++j) {
+        if (OID_IS_NULL(heads[j].head)) continue;
+
+        // need recovery
+        const auto id = j % kMaxThreadNum;
+        auto *tls_field = &(PrepareTLSChunk(node, pos, id / kBitNum)[id % kBitNum]);
+        tasks.emplace_back(RecoveryTask{&(heads[j].head), &(heads[j].tmp_head), tls_field,
+                                        {}, node});
+      }
+    }
+
+    // prepare stacks of spare lists for recycling drained lists
+    auto *spares_oid = &(root[kTargetNum * 3 + 1 + pos]);
+    if constexpr (Target::kSpareListNum > 0) {
+      if (OID_IS_NULL(*spares_oid)) {  // the first call
+        Zalloc(pop, spares_oid, sizeof(SpareLists) * kMaxThreadNum * kClasses);
+      }
+    } else if (!OID_IS_NULL(*spares_oid)) {  // recycling has been disabled
+      const auto spare_num = pmemobj_alloc_usable_size(*spares_oid) / sizeof(SpareLists);
+      auto *spares = reinterpret_cast<SpareLists *>(pmemobj_direct(*spares_oid));
+      for (size_t i = 0; i < spare_num; ++i) {
+        component::GarbageListInPMEM::ReleaseEmptyLists(&(spares[i].ready));
+        component::GarbageListInPMEM::ReleaseEmptyLists(&(spares[i].returned));
+      }
+      pmemobj_free(spares_oid);
+    }
+
+    // prepare a pool for sharing destructed pages among threads
+    auto *pool_oid = &(root[kTargetNum + pos]);
+    if (!OID_IS_NULL(*pool_oid)) {  // need recovery
+      auto *pool_tls = reinterpret_cast<TLSFields *>(pmemobj_direct(*pool_oid));
+      if (!OID_IS_NULL(pool_tls->head)) {
+        std::vector<const TLSFields *> others{};
+        for (size_t chunk = 0; chunk < kWordNum; ++chunk) {
+          const auto *tls_fields = GetTLSChunk(node, pos, chunk);
+          if (tls_fields == nullptr) continue;
+          for (size_t i = 0; i < kBitNum; ++i) {
+            others.emplace_back(&(tls_fields[i]));
+          }
+        }
+        tasks.emplace_back(RecoveryTask{&(pool_tls->head), &(pool_tls->tmp_head), pool_tls,  //
+                                        std::move(others), node, true});
+      }
+    }
+    if constexpr (Target::kReusePages && Target::kSharedPoolCapacity > 0) {
+      if (OID_IS_NULL(*pool_oid)) {
+        Zalloc(pop, pool_oid, sizeof(TLSFields));
+      }
+      auto *pool_tls = reinterpret_cast<TLSFields *>(pmemobj_direct(*pool_oid));
+      shared_pools_[node * kTargetNum + pos] = std::make_unique<component::SharedPagePool>(  //
+          pool_tls, Target::kSharedPoolCapacity);
+    }
+  }
+
+  /**
+   * @param node The NUMA node of a pool.
+   * @param pos The position of a target in a root region.
+   * @param chunk The position of a chunk in the directory of thread-local fields.
+   * @return The head of thread-local fields in the chunk if exist (nullptr
+   * otherwise).
+   */
+  [[nodiscard]] auto
+  GetTLSChunk(  //
+      const size_t node,
+      const size_t pos,
+      const size_t chunk) const  //
+      -> TLSFields *
+  {
+    const auto *dir = reinterpret_cast<const PMEMoid *>(pmemobj_direct(roots_[node][pos]));
+    if (dir == nullptr || OID_IS_NULL(dir[chunk])) return nullptr;
+    return GetTLSHead(pmemobj_direct(dir[chunk]));
+  }
+
+  /**
+   * @brief Allocate a chunk of thread-local fields if it does not exist.
+   *
+   * @param node The NUMA node of a pool.
+   * @param pos The position of a target in a root region.
+   * @param chunk The position of a chunk in the directory of thread-local fields.
+   * @return The head of thread-local fields in the chunk.
+   * @note Each chunk has the fields of `kBitNum` threads, and so the threads in
+   * a chunk share the same word of bitmaps.
+   */
+  auto
+  PrepareTLSChunk(  //
+      const size_t node,
+      const size_t pos,
+      const size_t chunk)  //
+      -> TLSFields *
+  {
+    auto *dir = reinterpret_cast<PMEMoid *>(pmemobj_direct(roots_[node][pos]));
+    if (OID_IS_NULL(dir[chunk])) {
+      Zalloc(pops_[node], &(dir[chunk]), sizeof(TLSFields) * (kBitNum + 1));
+    }
+    return GetTLSHead(pmemobj_direct(dir[chunk]));
+  }
+
+  /**
+   * @brief Allocate garbage lists of threads in a chunk and bind them to their
+   * persistent fields.
+   *
+   * @tparam Target A class for representing target garbage.
+   * @param node The NUMA node of a pool.
+   * @param pos The position of a target in a root region.
+   * @param chunk The position of a chunk in the directory of thread-local fields.
+   * @note This function is called by the first thread that uses the chunk, and
+   * it prepares the lists of all the size classes in the chunk. The lists are
+   * ordered by size class, and so `lists[cls * kBitNum]` is the list of the
+   * same thread in a size class `cls`.
+   */
+  template <class Target>
+  void
+  BindListChunk(  //
+      const size_t node,
+      const size_t pos,
+      const size_t chunk)
+  {
+    constexpr auto kClasses = kClassNum<Target>;
+
+    std::lock_guard guard{bind_mtx_};
+    auto &is_bound = bound_chunks_[(node * kTargetNum + pos) * kWordNum + chunk];
+    if (is_bound.load(kRelaxed)) return;
+
+    auto &lists = std::get<ListChunks<Target>>(garbage_lists_)[node * kWordNum + chunk];
+    lists.reset(new GarbageList<Target>[kClasses * kBitNum]);
+    auto *bitmap = &(active_lists_[node * kBitmapSize]);
+    const auto begin = chunk * kBitNum;
+    const auto end = std::min(begin + kBitNum, kMaxThreadNum);
+    if constexpr (Target::kOnPMEM) {
+      auto *pop = pops_[node];
+      auto *root = roots_[node];
+      auto *tls_fields = PrepareTLSChunk(node, pos, chunk);
+      auto *heads = reinterpret_cast<ListHeads *>(pmemobj_direct(root[kTargetNum * 2 + pos]));
+      auto *spares =
+          reinterpret_cast<SpareLists *>(pmemobj_direct(root[kTargetNum * 3 + 1 + pos]));
+      auto *shared_pool = shared_pools_[node * kTargetNum + pos].get();
+      for (size_t cls = 0; cls < kClasses; ++cls) {
+        auto *word = &(bitmap[(kClassOffsets[pos] + cls) * kWordNum + chunk]);
+        for (auto i = begin; i < end; ++i) {
+          auto &list = lists[cls * kBitNum + i - begin];
+          list.SetPMEMInfo(pop, &(tls_fields[i - begin]), word, 1UL << (i % kBitNum));
+          if (cls > 0) {
+            auto *heads_i = &(heads[(cls - 1) * kMaxThreadNum + i]);
+            list.SetListHeads(&(heads_i->head), &(heads_i->tmp_head));
+          }
+          if constexpr (Target::kSpareListNum > 0) {
+            list.SetSpareLists(&(spares[cls * kMaxThreadNum + i]), Target::kSpareListNum);
+          }
+          if (shared_pool != nullptr) {
+            list.SetSharedPool(shared_pool);
+          }
+        }
+      }
+    } else {
+      auto *word = &(bitmap[kClassOffsets[pos] * kWordNum + chunk]);
+      for (auto i = begin; i < end; ++i) {
+        lists[i - begin].SetActiveWord(word, 1UL << (i % kBitNum));
+      }
+    }
+    is_bound.store(true, kRelease);
+  }
+
+  /**
+   * @tparam Target A class for representing target garbage.
+   * @param node The NUMA node of target lists.
+   * @param chunk The position of a chunk of thread IDs.
+   * @return The garbage lists of the chunk if they have been bound (nullptr
+   * otherwise).
+   */
+  template <class Target>
+  [[nodiscard]] auto
+  GetListChunk(  //
+      const size_t node,
+      const size_t chunk) const  //
+      -> GarbageList<Target> *
+  {
+    constexpr auto kPos = GetTargetPos<Target>();
+    if (!bound_chunks_[(node * kTargetNum + kPos) * kWordNum + chunk].load(kAcquire)) {
+      return nullptr;
+    }
+    return std::get<ListChunks<Target>>(garbage_lists_)[node * kWordNum + chunk].get();
+  }
+
+  /**
+   * @param id The thread ID of a target chunk.
+   * @return The states of guards in the chunk that has the thread.
+   * @note A chunk is allocated when one of its threads creates a guard first.
+   */
+  auto
+  GetGuardChunk(        //
+      const size_t id)  //
+      -> GuardChunk &
+  {
+    auto &chunk = guard_chunks_[id / kBitNum];
+    auto *guards = chunk.load(kAcquire);
+    if (guards == nullptr) {
+      auto *new_guards = new GuardChunk{};
+      if (chunk.compare_exchange_strong(guards, new_guards, std::memory_order_acq_rel,
+                                        kAcquire)) {
+        guards = new_guards;
+      } else {
+        delete new_guards;  // other threads have allocated the chunk
+      }
+    }
+    return *guards;
+  }
+
+  /**
+   * @brief Release garbage lists left by a machine failure in parallel.
+   *
+   * @param tasks Garbage lists to be released.
+   * @note Each garbage list belongs to exactly one task, and temporary fields
+   * referred by tasks are not modified during recovery. Thus, multiple threads
+   * can release the lists without any synchronization.
+   */
+  void
+  RecoverGarbageLists(  //
+      const std::vector<RecoveryTask> &tasks)
+  {
+    if (tasks.empty()) return;
+
+    const auto start = Clock_t::now();
+    std::atomic_size_t next{0};
+    std::atomic_size_t garbage_num{0};
+    auto recover = [&]() {
+      size_t cnt = 0;
+      while (true) {
+        const auto i = next.fetch_add(1, kRelaxed);
+        if (i >= tasks.size()) break;
+
+        const auto &task = tasks[i];
+        if (!task.is_shared) {
+          cnt += component::GarbageListInPMEM::ReleaseAllGarbages(  //
+              task.head, task.tmp_head, task.tls);
+        } else {
+          cnt += component::GarbageListInPMEM::ReleaseAllGarbages(task.tls, task.others);
+        }
+      }
+      garbage_num.fetch_add(cnt, kRelaxed);
+    };
+
+    const auto thread_num = std::min(gc_thread_num_, tasks.size());
+    std::vector<std::thread> threads{};
+    threads.reserve(thread_num - 1);
+    for (size_t i = 1; i < thread_num; ++i) {
+      threads.emplace_back(recover);
+    }
+    recover();
+    for (auto &&t : threads) {
+      t.join();
+    }
+
+    recovery_info_.list_num += tasks.size();
+    recovery_info_.garbage_num += garbage_num.load(kRelaxed);
+    recovery_info_.time +=
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock_t::now() - start);
+  }
+
+  /**
+   * @brief Detach garbage lists from thread-local fields for background
+   * recovery.
+   *
+   * @param tasks Garbage lists to be released.
+   * @note Lists that cannot be detached (i.e., lists of shared page pools) are
+   * released in this function.
+   */
+  void
+  DetachGarbageLists(  //
+      const std::vector<RecoveryTask> &tasks)
+  {
+    // detached lists must be linked to slots in the same pool
+    std::vector<size_t> slot_nums(node_num_);
+    for (const auto &task : tasks) {
+      ++slot_nums[task.node];
+    }
+    std::vector<TLSFields *> slots(node_num_);
+    for (size_t node = 0; node < node_num_; ++node) {
+      if (slot_nums[node] == 0) continue;
+      auto *slots_oid = &(roots_[node][kTargetNum * 3]);
+      Zalloc(pops_[node], slots_oid, sizeof(TLSFields) * slot_nums[node]);
+      slots[node] = reinterpret_cast<TLSFields *>(pmemobj_direct(*slots_oid));
+    }
+
+    std::vector<RecoveryTask> remaining{};
+    for (const auto &task : tasks) {
+      auto *slot = slots[task.node]++;
+      if (!task.is_shared
+          && component::GarbageListInPMEM::DetachAllGarbages(  //
+              task.head, task.tmp_head, task.tls, slot)) {
+        recovery_tasks_.emplace_back(RecoveryTask{&(slot->head), &(slot->tmp_head), slot,  //
+                                                  {}, task.node});
+      } else {
+        remaining.emplace_back(task);
+      }
+    }
+    RecoverGarbageLists(remaining);
+  }
+
+  /**
+   * @brief Release garbage lists detached by previous background recovery.
+   *
+   */
+  void
+  ReleaseDetachedLists()
+  {
+    std::vector<RecoveryTask> tasks{};
+    for (size_t node = 0; node < node_num_; ++node) {
+      auto *slots_oid = &(roots_[node][kTargetNum * 3]);
+      if (OID_IS_NULL(*slots_oid)) continue;
+
+      const auto slot_num = pmemobj_alloc_usable_size(*slots_oid) / sizeof(TLSFields);
+      auto *slots = reinterpret_cast<TLSFields *>(pmemobj_direct(*slots_oid));
+      for (size_t i = 0; i < slot_num; ++i) {
+        auto *slot = &(slots[i]);
+        if (OID_IS_NULL(slot->head)) continue;
+        tasks.emplace_back(RecoveryTask{&(slot->head), &(slot->tmp_head), slot, {}, node});
+      }
+    }
+    RecoverGarbageLists(tasks);
+
+    for (size_t node = 0; node < node_num_; ++node) {
+      auto *slots_oid = &(roots_[node][kTargetNum * 3]);
+      if (OID_IS_NULL(*slots_oid)) continue;
+      pmemobj_free(slots_oid);
+    }
+  }
+
+  /**
+   * @brief Destroy all the garbage lists for destruction.
+   *
+   * The remaining garbage of each target is released in parallel before the
+   * lists are destroyed, and so destructors are called target by target.
+   *
+   * @tparam Target The current class in garbage targets.
+   * @tparam Tails The remaining classes in garbage targets.
+   * @param fast_shutdown A flag for leaving garbage for the next construction.
+   * @param pos The position of the current target in a root region.
+   */
+  template <class Target, class... Tails>
+  void
+  DestroyGarbageLists(  //
+      const bool fast_shutdown = false,
+      const size_t pos = 0)
+  {
+    constexpr auto kChunkSize = kClassNum<Target> * kBitNum;
+
+    auto &lists = std::get<ListChunks<Target>>(garbage_lists_);
+    if (lists) {
+      RunInParallel(node_num_ * kWordNum * kChunkSize, [&](const size_t i) {
+        const auto chunk = i / kChunkSize;
+        auto *chunk_lists = GetListChunk<Target>(chunk / kWordNum, chunk % kWordNum);
+        if (chunk_lists == nullptr) return;  // no thread has used the chunk
+        if constexpr (Target::kOnPMEM) {
+          if (fast_shutdown) {
+            chunk_lists[i % kChunkSize].Detach();
+            return;
+          }
+        }
+        chunk_lists[i % kChunkSize].Drain();
+      });
+      retired_stats_[pos] = SumListStats<Target>();
+      lists.reset(nullptr);
+    }
+    for (size_t node = 0; node < node_num_; ++node) {
+      shared_pools_[node * kTargetNum + pos].reset(nullptr);
+    }
+
+    if constexpr (sizeof...(Tails) > 0) {
+      DestroyGarbageLists<Tails...>(fast_shutdown, pos + 1);
+    }
+  }
+
+  /**
+   * @tparam Target A class for representing target garbage.
+   * @return The sum of list counters in every node, thread, and size class.
+   * @note The lists of the target must exist.
+   */
+  template <class Target>
+  [[nodiscard]] auto
+  SumListStats() const  //
+      -> Stats
+  {
+    Stats stats{};
+    size_t created = 0;
+    size_t removed = 0;
+    for (size_t i = 0; i < node_num_ * kWordNum * kClassNum<Target> * kBitNum; ++i) {
+      const auto chunk = i / (kClassNum<Target> * kBitNum);
+      const auto *lists = GetListChunk<Target>(chunk / kWordNum, chunk % kWordNum);
+      if (lists == nullptr) continue;
+
+      const auto &list = lists[i % (kClassNum<Target> * kBitNum)];
+      for (const auto *counters : {&(list.GetClientStats()), &(list.GetGCStats())}) {
+        stats.added += counters->added.load(kRelaxed);
+        stats.destructed += counters->destructed.load(kRelaxed);
+        stats.released += counters->released.load(kRelaxed);
+        stats.reused += counters->reused.load(kRelaxed);
+        stats.reuse_misses += counters->reuse_misses.load(kRelaxed);
+        stats.persist_num += counters->persist_num.load(kRelaxed);
+        stats.free_num += counters->free_num.load(kRelaxed);
+        created += counters->created_lists.load(kRelaxed);
+        removed += counters->removed_lists.load(kRelaxed);
+      }
+    }
+    stats.live_lists = created > removed ? created - removed : 0;
+    return stats;
+  }
+
+  /**
+   * @brief Run a given procedure for each index by cleaner threads in parallel.
+   *
+   * @tparam Func A class of a procedure that receives an index.
+   * @param num The number of indices.
+   * @param func A procedure to be run.
+   */
+  template <class Func>
+  void
+  RunInParallel(  //
+      const size_t num,
+      Func &&func)
+  {
+    std::atomic_size_t next{0};
+    auto worker = [&]() {
+      for (auto i = next.fetch_add(1, kRelaxed); i < num; i = next.fetch_add(1, kRelaxed)) {
+        func(i);
+      }
+    };
+
+    std::vector<std::thread> threads{};
+    threads.reserve(gc_thread_num_ - 1);
+    for (size_t i = 1; i < gc_thread_num_; ++i) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &&t : threads) {
+      t.join();
+    }
+  }
+
+  /*############################################################################
+   * Additional utilities for persistent memory
+   *##########################################################################*/
+
+  /**
+   * @tparam Target a class for representing a target garbage.
+   * @tparam Head The current class in garbage targets.
+   * @tparam Tails The remaining classes in garbage targets.
+   * @param pos The position of the current target in a root region.
+   * @return Unreleased temporary fields if exist.
+   */
+  template <class Target, class Head, class... Tails>
+  auto
+  GetRemainingPMEMoids(      //
+      const size_t pos = 0)  //
+      -> std::vector<PMEMoid *>
+  {
+    if constexpr (std::is_same_v<Target, Head>) {
+      std::vector<PMEMoid *> list_vec{};
+      for (size_t node = 0; node < node_num_; ++node) {
+        for (size_t chunk = 0; chunk < kWordNum; ++chunk) {
+          auto *tls_fields = GetTLSChunk(node, pos, chunk);
+          if (tls_fields == nullptr) continue;
+          for (size_t i = 0; i < kBitNum; ++i) {
+            auto *arr = tls_fields[i].GetRemainingFields();
+            if (arr == nullptr) continue;
+            list_vec.emplace_back(arr);
+          }
+        }
+      }
+      return list_vec;
+    } else {
+      return GetRemainingPMEMoids<Target, Tails...>(pos + 1);
+    }
+  }
+
+  /*############################################################################
+   * Internal utility functions
+   *##########################################################################*/
+
+  /**
+   * @tparam Target A class for representing target garbage.
+   * @param cls The size class of target garbage.
+   * @return The head of a linked list of garbage nodes and its mutex object.
+   * @note In the NUMA-aware mode, this function returns a list in the pool of
+   * the node of the current thread.
+   */
+  template <class Target>
+  [[nodiscard]] auto
+  GetGarbageList(  //
+      const size_t cls = 0)
+  {
+    constexpr auto kPos = GetTargetPos<Target>();
+
+    const auto id = ::dbgroup::thread::IDManager::GetThreadID();
+    const auto node = (node_num_ > 1) ? GetCurrentNode() % node_num_ : 0;
+    const auto chunk = id / kBitNum;
+    if (!bound_chunks_[(node * kTargetNum + kPos) * kWordNum + chunk].load(kAcquire)) {
+      BindListChunk<Target>(node, kPos, chunk);
+    }
+    const auto &lists = std::get<ListChunks<Target>>(garbage_lists_)[node * kWordNum + chunk];
+    return &(lists[cls * kBitNum + id % kBitNum]);
+  }
+
+  /**
+   * @brief Add a new garbage instance to the lists of the current thread.
    *
    * @tparam Target A class for representing target garbage.
+   * @tparam kAssigned A flag for skipping the check of list owners.
+   * @param lists The list of the smallest size class in the current thread.
    * @param oid A pointer to a target garbage.
+   * @param birth An epoch when the garbage was allocated.
    */
-  template <class Target = DefaultTarget>
+  template <class Target, bool kAssigned>
   void
-  AddGarbage(  //
-      PMEMoid *oid)
+  AddGarbageToLists(  //
+      GarbageList<Target> *lists,
+      PMEMoid *oid,
+      const size_t birth = 0)
   {
-    GetGarbageList<Target>()->AddGarbage(epoch_manager_.GetCurrentEpoch(), oid);
+    const auto epoch = epoch_manager_.GetCurrentEpoch();
+    auto *list = &(lists[GetClassOfPage<Target>(*oid) * kBitNum]);
+    const auto cnt = list->template AddGarbage<kAssigned>(epoch, oid, birth);
+    if (gc_watermark_ > 0 && cnt % gc_watermark_ == 0) {
+      RequestGC();
+    }
+    ApplyQuotas<Target>(list);
   }
 
   /**
-   * @brief Reuse a released memory page if it exists.
+   * @brief Add new garbage instances to the lists of the current thread.
    *
    * @tparam Target A class for representing target garbage.
-   * @param[out] out_oid The address to be stored a reusable page.
+   * @tparam kAssigned A flag for skipping the check of list owners.
+   * @param lists The list of the smallest size class in the current thread.
+   * @param oids Consecutive temporary fields that hold target garbage.
+   * @param n The number of target garbage.
    */
-  template <class Target = DefaultTarget>
+  template <class Target, bool kAssigned>
   void
-  GetPageIfPossible(  //
-      PMEMoid *out_oid)
+  AddGarbagesToLists(  //
+      GarbageList<Target> *lists,
+      PMEMoid *oids,
+      const size_t n)
   {
-    static_assert(Target::kReusePages);
-    GetGarbageList<Target>()->GetPageIfPossible(out_oid);
+    const auto epoch = epoch_manager_.GetCurrentEpoch();
+    if constexpr (kClassNum<Target> > 1 || Target::kIntervalBased) {
+      // each list has its own counter, and so check the watermark for each one
+      for (size_t i = 0; i < n; ++i) {
+        auto *list = &(lists[GetClassOfPage<Target>(oids[i]) * kBitNum]);
+        const auto cnt = list->template AddGarbage<kAssigned>(epoch, &oids[i]);
+        if (gc_watermark_ > 0 && cnt % gc_watermark_ == 0) {
+          RequestGC();
+        }
+        ApplyQuotas<Target>(list);
+      }
+    } else {
+      const auto cnt = lists->template AddGarbages<kAssigned>(epoch, oids, n);
+      if (gc_watermark_ > 0 && (cnt - n) / gc_watermark_ != cnt / gc_watermark_) {
+        RequestGC();
+      }
+      ApplyQuotas<Target>(lists);
+    }
   }
 
-  /*############################################################################
-   * Public GC control functions
-   *##########################################################################*/
-
   /**
-   * @brief Start garbage collection.
+   * @brief Reuse a released memory page in the lists of the current thread.
    *
-   * @retval true if garbage collection has started.
-   * @retval false if garbage collection is already running.
+   * @tparam Target A class for representing target garbage.
+   * @tparam kAssigned A flag for skipping the check of list owners.
+   * @param lists The list of the smallest size class in the current thread.
+   * @param[out] out_oid The address to be stored a reusable page.
+   * @param size The desired size of a page.
    */
-  auto
-  StartGC()  //
-      -> bool
+  template <class Target, bool kAssigned>
+  void
+  GetPageFromLists(  //
+      GarbageList<Target> *lists,
+      PMEMoid *out_oid,
+      const size_t size)
   {
-    if (gc_is_running_.load(std::memory_order_relaxed)) return false;
-
-    gc_is_running_.store(true, std::memory_order_relaxed);
-    gc_thread_ = std::thread{&EpochBasedGC::RunGC, this};
-    return true;
+    static_assert(Target::kReusePages);
+    if constexpr (kClassNum<Target> > 1) {
+      const auto cls = GetClassOfSize<Target>(size);
+      if (cls == kClassNum<Target>) return;
+      lists[cls * kBitNum].template GetPageIfPossible<kAssigned>(out_oid);
+    } else {
+      lists->template GetPageIfPossible<kAssigned>(out_oid);
+    }
   }
 
   /**
-   * @brief Stop garbage collection.
+   * @brief Allocate a page to a temporary field of the current thread.
    *
-   * @retval true if garbage collection has stopped.
-   * @retval false if garbage collection is not running.
+   * @tparam Target A class for representing target garbage.
+   * @tparam kAssigned A flag for skipping the check of list owners.
+   * @param lists The list of the smallest size class in the current thread.
+   * @param pop A pmemobj pool for allocating a page.
+   * @param i The position of temporary fields.
+   * @param size The desired size of a page.
+   * @return The address of the temporary field that holds the page.
    */
+  template <class Target, bool kAssigned>
   auto
-  StopGC()  //
-      -> bool
+  AllocateOnLists(  //
+      GarbageList<Target> *lists,
+      PMEMobjpool *pop,
+      const size_t i,
+      const size_t size)  //
+      -> PMEMoid *
   {
-    if (!gc_is_running_.load(std::memory_order_relaxed)) return false;
+    auto *oid = lists->template GetTmpField<kAssigned>(i);
+    if constexpr (Target::kReusePages) {
+      GetPageFromLists<Target, kAssigned>(lists, oid, size);
+      if (!OID_IS_NULL(*oid)) return oid;
+    }
 
-    gc_is_running_.store(false, std::memory_order_relaxed);
-    gc_thread_.join();
-    DestroyGarbageLists<DefaultTarget, GCTargets...>();
-    return true;
+    if constexpr (kClassNum<Target> > 1) {
+      const auto cls = GetClassOfSize<Target>(size);
+      if (cls == kClassNum<Target>) {
+        Malloc(pop, oid, size);  // a large page does not fit any magazine
+      } else {
+        lists[cls * kBitNum].AllocatePage(pop, oid, Target::kPageSizes[cls]);
+      }
+    } else {
+      lists->AllocatePage(pop, oid, size);
+    }
+    return oid;
   }
 
- private:
-  /*############################################################################
-   * Internal constants
-   *##########################################################################*/
-
-  /// @brief The expected maximum number of threads.
-  static constexpr size_t kMaxThreadNum = ::dbgroup::thread::kMaxThreadNum;
-
-  /*############################################################################
-   * Internal utilities for initialization and finalization
-   *##########################################################################*/
-
   /**
-   * @brief A dummy function for creating type aliases.
-   *
+   * @tparam Target A class for representing target garbage.
+   * @param size The desired size of a page.
+   * @return The smallest size class that can hold `size` bytes (the number of
+   * classes if there is no such class).
    */
-  template <class Target, class... Tails>
-  static auto
-  ConvToTuple()
+  template <class Target>
+  [[nodiscard]] static constexpr auto
+  GetClassOfSize(         //
+      const size_t size)  //
+      -> size_t
   {
-    using ListsPtr = std::unique_ptr<GarbageList<Target>[]>;
-    if constexpr (sizeof...(Tails) > 0) {
-      return std::tuple_cat(std::tuple<ListsPtr>{}, ConvToTuple<Tails...>());
-    } else {
-      return std::tuple<ListsPtr>{};
+    size_t cls = 0;
+    for (; cls < kClassNum<Target> && Target::kPageSizes[cls] < size; ++cls) {
+      // search the smallest size class that fits
     }
+    return cls;
   }
 
   /**
-   * @param addr The begin address.
-   * @return The head of thread local regions.
+   * @tparam Target A class for representing target garbage.
+   * @param oid A target page.
+   * @return The largest size class whose size is not greater than the page.
    */
-  static constexpr auto
-  GetTLSHead(            //
-      const void *addr)  //
-      -> TLSFields *
+  template <class Target>
+  [[nodiscard]] static auto
+  GetClassOfPage(         //
+      const PMEMoid &oid)  //
+      -> size_t
   {
-    constexpr uintptr_t kMask = kPMEMLineSize - 1;
-    auto ptr = reinterpret_cast<uintptr_t>(addr);
-    if ((ptr & kMask) > 0) {
-      // move the address to the Intel Optane alignment
-      ptr = (ptr & ~kMask) + kPMEMLineSize;
+    if constexpr (Target::kReusePages && kClassNum<Target> > 1) {
+      const auto size = pmemobj_alloc_usable_size(oid);
+      size_t cls = kClassNum<Target> - 1;
+      for (; cls > 0 && Target::kPageSizes[cls] > size; --cls) {
+        // search the largest size class that the page can hold
+      }
+      return cls;
+    } else {
+      return 0;
     }
-    return reinterpret_cast<TLSFields *>(ptr);
   }
 
   /**
-   * @brief Create the space for garbage lists for all the target garbage.
+   * @brief Clear registered garbage in active lists if possible.
    *
    * @tparam Target The current class in garbage targets.
    * @tparam Tails The remaining classes in garbage targets.
+   * @param target The position of a target to be cleared.
+   * @param intervals A snapshot of epochs to be protected.
+   * @param node The NUMA node of target lists.
+   * @param id The thread ID of target lists.
    * @param pos The position of the current target in a root region.
+   * @retval true if there may be garbage to be collected.
+   * @retval false otherwise.
    */
   template <class Target, class... Tails>
-  void
-  InitializeGarbageLists(  //
-      const size_t pos = 0)
+  auto
+  ClearGarbage(  //
+      const size_t target,
+      const ReservedIntervals &intervals,
+      const size_t node,
+      const size_t id,
+      const size_t pos = 0)  //
+      -> bool
   {
-    using ListsPtr = std::unique_ptr<GarbageList<Target>[]>;
-    auto &lists = std::get<ListsPtr>(garbage_lists_);
-    lists.reset(new GarbageList<Target>[kMaxThreadNum]);
+    if (pos != target) {
+      if constexpr (sizeof...(Tails) > 0) {
+        return ClearGarbage<Tails...>(target, intervals, node, id, pos + 1);
+      }
+      return false;
+    }
 
-    auto *list_oid = &(root_[pos]);
-    if (OID_IS_NULL(*list_oid)) {  // the first call
-      Zalloc(pop_, list_oid, sizeof(TLSFields) * (kMaxThreadNum + 1));
+    const auto word_id = id / kBitNum;
+    auto *lists = GetListChunk<Target>(node, word_id);
+    if (lists == nullptr) return false;
+
+    const auto mask = 1UL << (id % kBitNum);
+    auto has_garbage = false;
+    for (size_t cls = 0; cls < kClassNum<Target>; ++cls) {
+      const auto word_pos = node * kBitmapSize + (kClassOffsets[pos] + cls) * kWordNum + word_id;
+      if ((active_lists_[word_pos].load(std::memory_order_relaxed) & mask) == 0) continue;
+
+      auto &list = lists[cls * kBitNum + id % kBitNum];
+      if constexpr (Target::kIntervalBased) {
+        has_garbage |= list.ClearGarbage(intervals.protected_epoch, &intervals);
+      } else {
+        has_garbage |= list.ClearGarbage(intervals.protected_epoch);
+      }
     }
+    return has_garbage;
+  }
 
-    auto *tls_fields = GetTLSHead(pmemobj_direct(*list_oid));
-    for (size_t i = 0; i < kMaxThreadNum; ++i) {
-      auto *tls_field = &(tls_fields[i]);
-      if (!OID_IS_NULL(tls_field->head)) {  // need recovery
-        component::GarbageListInPMEM::ReleaseAllGarbages(tls_field);
+  /**
+   * @param pos The position of a target in a root region.
+   * @param node The NUMA node of target lists.
+   * @param begin The first thread ID to be checked.
+   * @param end The thread ID next to the last one to be checked.
+   * @return The first thread ID that has garbage lists of any size class (`end`
+   * if no list is active).
+   */
+  [[nodiscard]] auto
+  FindActiveID(  //
+      const size_t pos,
+      const size_t node,
+      const size_t begin,
+      const size_t end) const  //
+      -> size_t
+  {
+    const auto *bitmap = &(active_lists_[node * kBitmapSize]);
+    for (auto word_id = begin / kBitNum; word_id * kBitNum < end; ++word_id) {
+      uint64_t bits = 0;
+      for (auto cls = kClassOffsets[pos]; cls < kClassOffsets[pos + 1]; ++cls) {
+        bits |= bitmap[cls * kWordNum + word_id].load(std::memory_order_relaxed);
       }
-      lists[i].SetPMEMInfo(pop_, tls_field);
+      if (word_id == begin / kBitNum) {
+        bits &= ~0UL << (begin % kBitNum);  // ignore already claimed IDs
+      }
+      if (bits > 0) return std::min(word_id * kBitNum + __builtin_ctzl(bits), end);
     }
+    return end;
+  }
 
-    if constexpr (sizeof...(Tails) > 0) {
-      InitializeGarbageLists<Tails...>(pos + 1);
+  /**
+   * @param pos The position of a target in a root region.
+   * @retval true if any list of the target has garbage.
+   * @retval false otherwise.
+   */
+  [[nodiscard]] auto
+  HasActiveLists(        //
+      const size_t pos)  //
+      -> bool
+  {
+    for (size_t node = 0; node < node_num_; ++node) {
+      const auto *bitmap = &(active_lists_[node * kBitmapSize]);
+      for (auto i = kClassOffsets[pos] * kWordNum; i < kClassOffsets[pos + 1] * kWordNum; ++i) {
+        if (bitmap[i].load(std::memory_order_relaxed) != 0) return true;
+      }
     }
+    return false;
   }
 
   /**
-   * @brief Destroy all the garbage lists for destruction.
+   * @brief Clear registered garbage in the own shard and steal the others.
    *
-   * @tparam Target The current class in garbage targets.
-   * @tparam Tails The remaining classes in garbage targets.
-   * @param pos The position of the current target in a root region.
+   * Each cleaner thread first releases the garbage lists of its own range of
+   * thread IDs. After that, the cleaner visits the other shards and helps them
+   * if they have lists that have not been claimed in the current pass yet.
+   * Thread IDs are claimed one by one, and the bitmaps of active lists are
+   * used to skip idle IDs without touching their lists. Cleaners wake up
+   * independently, and so the first cleaner that visits a shard in each epoch
+   * starts a new pass of the shard. In the NUMA-aware mode,
+   * shards of the same node are adjacent, and so each cleaner helps the
+   * cleaners of its node before visiting remote ones.
+   *
+   * Targets are cleared in descending order of `kGCPriority`, and a target is
+   * skipped until `kGCIntervalMicroSec` has passed since the cleaner cleared it.
+   *
+   * @param shard_id The ID of a shard that is owned by the current cleaner.
+   * @param intervals A snapshot of epochs to be protected.
+   * @param[in,out] cleared The last time when the cleaner cleared each target.
+   * @retval true if there may be garbage to be collected.
+   * @retval false otherwise.
    */
-  template <class Target, class... Tails>
-  void
-  DestroyGarbageLists(  //
-      const size_t pos = 0)
+  auto
+  ClearGarbageInShards(  //
+      const size_t shard_id,
+      const ReservedIntervals &intervals,
+      std::array<Clock_t::time_point, kTargetNum> &cleared)  //
+      -> bool
   {
-    using ListsPtr = std::unique_ptr<GarbageList<Target>[]>;
-    auto &lists = std::get<ListsPtr>(garbage_lists_);
-    lists.reset(nullptr);
+    const auto now = Clock_t::now();
+    const auto epoch = epoch_manager_.GetCurrentEpoch();
+    auto has_garbage = false;
+    std::array<bool, kTargetNum> due{};
+    for (size_t pos = 0; pos < kTargetNum; ++pos) {
+      due[pos] = now >= cleared[pos] + kTargetIntervals[pos];
+      if (due[pos]) {
+        cleared[pos] = now;
+      } else {
+        has_garbage |= HasActiveLists(pos);  // prevent adaptive GC from backing off
+      }
+    }
 
-    if constexpr (sizeof...(Tails) > 0) {
-      DestroyGarbageLists<Tails...>(pos + 1);
+    for (const auto pos : kPriorityOrder) {
+      if (!due[pos]) continue;
+      for (size_t i = 0; i < gc_thread_num_; ++i) {
+        auto &shard = shards_[(shard_id + i) % gc_thread_num_];
+        auto pass = shard.pass[pos].load(std::memory_order_relaxed);
+        if (pass != epoch
+            && shard.pass[pos].compare_exchange_strong(pass, epoch, std::memory_order_relaxed)) {
+          shard.pos[pos].store(shard.begin, std::memory_order_relaxed);
+        }
+        auto cur = shard.pos[pos].load(std::memory_order_relaxed);
+        while (cur < shard.end) {
+          const auto id = FindActiveID(pos, shard.node, cur, shard.end);
+          if (!shard.pos[pos].compare_exchange_weak(cur, id + 1, std::memory_order_relaxed)) {
+            continue;  // other cleaners have claimed the ID
+          }
+          if (id < shard.end) {
+            has_garbage |= ClearGarbage<DefaultTarget, GCTargets...>(  //
+                pos, intervals, shard.node, id);
+          }
+          cur = id + 1;
+        }
+      }
     }
+    return has_garbage;
   }
 
-  /*############################################################################
-   * Additional utilities for persistent memory
-   *##########################################################################*/
-
   /**
-   * @tparam Target a class for representing a target garbage.
-   * @tparam Head The current class in garbage targets.
-   * @tparam Tails The remaining classes in garbage targets.
-   * @param pos The position of the current target in a root region.
-   * @return Unreleased temporary fields if exist.
+   * @brief Pin a cleaner thread to the CPUs of its node in the NUMA-aware mode.
+   *
+   * @param shard_id The ID of a shard that is owned by the current cleaner.
    */
-  template <class Target, class Head, class... Tails>
-  auto
-  GetRemainingPMEMoids(      //
-      const size_t pos = 0)  //
-      -> std::vector<PMEMoid *>
+  void
+  PinCleanerIfNeeded(  //
+      const size_t shard_id)
   {
-    if constexpr (std::is_same_v<Target, Head>) {
-      std::vector<PMEMoid *> list_vec{};
-      list_vec.reserve(kMaxThreadNum);
+    if (node_num_ > 1) {
+      PinCurrentThread(shards_[shard_id].node);
+    }
+  }
 
-      auto *tls_fields = GetTLSHead(pmemobj_direct(root_[pos]));
-      for (size_t i = 0; i < kMaxThreadNum; ++i) {
-        auto *tls = &(tls_fields[i]);
-        auto *arr = tls->GetRemainingFields();
-        if (arr == nullptr) continue;
-        list_vec.emplace_back(arr);
+  /**
+   * @brief Create a snapshot of epochs reserved by epoch and interval guards.
+   *
+   * @return The protected epochs.
+   * @note The minimum epoch of epoch guards must be read before intervals so
+   * that an interval guard missed in the snapshot starts after the epoch.
+   */
+  [[nodiscard]] auto
+  SnapshotIntervals() const  //
+      -> ReservedIntervals
+  {
+    ReservedIntervals snapshot{};
+    snapshot.min_epoch = epoch_manager_.GetMinEpoch();
+    snapshot.protected_epoch = snapshot.min_epoch;
+    const auto end = interval_end_.load();
+    for (size_t chunk = 0; chunk * kBitNum < end; ++chunk) {
+      const auto *guards = guard_chunks_[chunk].load(kAcquire);
+      if (guards == nullptr) continue;
+      for (const auto &slot : guards->intervals) {
+        const auto lower = slot.lower.load();
+        if (lower == kNoReservation) continue;
+        snapshot.intervals.emplace_back(lower, slot.upper.load());
+        snapshot.protected_epoch = std::min(snapshot.protected_epoch, lower);
       }
-      return list_vec;
-    } else {
-      return GetRemainingPMEMoids<Target, Tails...>(pos + 1);
     }
+    return snapshot;
   }
 
-  /*############################################################################
-   * Internal utility functions
-   *##########################################################################*/
+  /**
+   * @return The minimum epoch protected by epoch and interval guards.
+   */
+  [[nodiscard]] auto
+  GetProtectedEpoch() const  //
+      -> size_t
+  {
+    auto protected_epoch = epoch_manager_.GetMinEpoch();
+    const auto end = interval_end_.load();
+    for (size_t chunk = 0; chunk * kBitNum < end; ++chunk) {
+      const auto *guards = guard_chunks_[chunk].load(kAcquire);
+      if (guards == nullptr) continue;
+      for (const auto &slot : guards->intervals) {
+        protected_epoch = std::min(protected_epoch, slot.lower.load());
+      }
+    }
+    return protected_epoch;
+  }
 
   /**
+   * @brief Reclaim garbage of the current thread if it exceeds its quotas.
+   *
+   * If the current thread holds more than `kSoftListQuota` garbage lists, it
+   * releases at most `kQuotaReleaseNum` of its own unprotected garbage instead
+   * of waiting for cleaner threads. If it still holds more than
+   * `kHardListQuota` lists, it requests the GC thread to forward the global
+   * epoch, waits for the forwarding, and retries until the number of lists
+   * falls within the quota.
+   *
    * @tparam Target A class for representing target garbage.
-   * @return The head of a linked list of garbage nodes and its mutex object.
+   * @param list The garbage list of the current thread.
+   * @note Garbage added within a guard of the current thread is never released
+   * until the guard is destroyed. Thus, the backpressure returns immediately
+   * if the current thread holds a reentrant or interval guard, and it gives up
+   * if the protected epoch does not advance over `kQuotaRetryNum` forwarded
+   * epochs (e.g., in an epoch guard of the current thread).
    */
   template <class Target>
-  [[nodiscard]] auto
-  GetGarbageList()
+  void
+  ApplyQuotas(  //
+      GarbageList<Target> *list)
   {
-    using ListsPtr = std::unique_ptr<GarbageList<Target>[]>;
+    constexpr auto kSoft = Target::kSoftListQuota;
+    constexpr auto kHard = Target::kHardListQuota;
+    static_assert(kSoft == 0 || kHard == 0 || kSoft < kHard,
+                  "a soft quota must be less than a hard one.");
+
+    if constexpr (kSoft > 0) {
+      if (list->GetLiveListNum() <= kSoft) return;
+      list->ClearGarbage(GetProtectedEpoch(), nullptr, kQuotaReleaseNum);
+    }
+    if constexpr (kHard > 0) {
+      if (list->GetLiveListNum() <= kHard || IsGuardedByCurrentThread()) return;
+      auto protected_epoch = GetProtectedEpoch();
+      for (size_t stalled = 0; stalled <= kQuotaRetryNum;) {
+        list->ClearGarbage(protected_epoch, nullptr, kQuotaReleaseNum);
+        if (list->GetLiveListNum() <= kHard) return;
+
+        WaitForNextEpoch();
+        const auto cur = GetProtectedEpoch();
+        stalled = (cur == protected_epoch) ? stalled + 1 : 0;
+        protected_epoch = cur;
+      }
+    }
+  }
 
-    return &(std::get<ListsPtr>(garbage_lists_)[::dbgroup::thread::IDManager::GetThreadID()]);
+  /**
+   * @retval true if the current thread holds a reentrant or interval guard.
+   * @retval false otherwise.
+   */
+  [[nodiscard]] auto
+  IsGuardedByCurrentThread() const  //
+      -> bool
+  {
+    const auto id = ::dbgroup::thread::IDManager::GetThreadID();
+    const auto *guards = guard_chunks_[id / kBitNum].load(kAcquire);
+    if (guards == nullptr) return false;  // the thread has never created guards
+    return guards->depths[id % kBitNum].depth > 0
+           || guards->intervals[id % kBitNum].lower.load(std::memory_order_relaxed)
+                  != kNoReservation;
   }
 
   /**
-   * @brief Clear registered garbage if possible.
+   * @brief Request GC and wait until the GC thread forwards the global epoch.
    *
-   * @tparam Target The current class in garbage targets.
-   * @tparam Tails The remaining classes in garbage targets.
-   * @param protected_epoch An epoch to be protected.
+   * @note This function waits for one interval of GC at most (e.g., if GC is
+   * not running).
    */
-  template <class Target, class... Tails>
   void
-  ClearGarbage(const size_t protected_epoch)
+  WaitForNextEpoch()
   {
-    using ListsPtr = std::unique_ptr<GarbageList<Target>[]>;
-
-    auto &lists = std::get<ListsPtr>(garbage_lists_);
-    for (size_t i = 0; i < kMaxThreadNum; ++i) {
-      lists[i].ClearGarbage(protected_epoch);
+    size_t pass{};
+    {
+      std::lock_guard guard{gc_mtx_};
+      pass = gc_pass_;
     }
+    RequestGC();
 
-    if constexpr (sizeof...(Tails) > 0) {
-      ClearGarbage<Tails...>(protected_epoch);
-    }
+    std::unique_lock lock{gc_mtx_};
+    cleaner_cv_.wait_for(lock, gc_interval_, [&]() {
+      return pass != gc_pass_ || !gc_is_running_.load(std::memory_order_relaxed);
+    });
+  }
+
+  /**
+   * @brief Wake up the GC thread to forward the global epoch.
+   *
+   */
+  void
+  RequestGC()
+  {
+    if (gc_requested_.exchange(true, std::memory_order_relaxed)) return;
+
+    std::lock_guard guard{gc_mtx_};
+    gc_cv_.notify_one();
   }
 
   /**
@@ -427,15 +2435,22 @@ class EpochBasedGC
   void
   RunGC()
   {
+    if (gc_watermark_ > 0) {
+      RunAdaptiveGC();
+      return;
+    }
+
     // create cleaner threads
     for (size_t i = 0; i < gc_thread_num_; ++i) {
-      cleaner_threads_.emplace_back([&]() {
+      cleaner_threads_.emplace_back([this, i]() {
+        PinCleanerIfNeeded(i);
+        std::array<Clock_t::time_point, kTargetNum> cleared{};
         for (auto wake_time = Clock_t::now() + gc_interval_;  //
              gc_is_running_.load(std::memory_order_relaxed);  //
              wake_time += gc_interval_)                       //
         {
           // release unprotected garbage
-          ClearGarbage<DefaultTarget, GCTargets...>(epoch_manager_.GetMinEpoch());
+          ClearGarbageInShards(i, SnapshotIntervals(), cleared);
 
           // wait until the next epoch
           std::this_thread::sleep_until(wake_time);
@@ -445,15 +2460,102 @@ class EpochBasedGC
 
     // manage the global epoch
     for (auto wake_time = Clock_t::now() + gc_interval_;  //
-         gc_is_running_.load(std::memory_order_relaxed);  //
-         wake_time += gc_interval_)                       //
+         gc_is_running_.load(std::memory_order_relaxed);)
     {
-      // wait until the next epoch
-      std::this_thread::sleep_until(wake_time);
+      // wait until the next epoch or a request of client threads
+      {
+        std::unique_lock lock{gc_mtx_};
+        gc_cv_.wait_until(lock, wake_time, [&]() {
+          return gc_requested_.load(std::memory_order_relaxed)
+                 || !gc_is_running_.load(std::memory_order_relaxed);
+        });
+      }
+      if (!gc_requested_.exchange(false, std::memory_order_relaxed)) {
+        wake_time += gc_interval_;
+      }
+      epoch_manager_.ForwardGlobalEpoch();
+
+      // notify client threads waiting for the epoch
+      {
+        std::lock_guard guard{gc_mtx_};
+        ++gc_pass_;
+      }
+      cleaner_cv_.notify_all();
+    }
+
+    // wait all the cleaner threads return
+    for (auto &&t : cleaner_threads_) {
+      t.join();
+    }
+    cleaner_threads_.clear();
+  }
+
+  /**
+   * @brief Run a procedure of garbage collection triggered by client threads.
+   *
+   * The GC thread forwards the global epoch when client threads request GC or
+   * the current interval has passed, and then wakes up cleaner threads. If
+   * cleaner threads do not find any garbage, the interval is doubled up to
+   * `kMaxBackoff` times the default one.
+   */
+  void
+  RunAdaptiveGC()
+  {
+    // create cleaner threads
+    for (size_t i = 0; i < gc_thread_num_; ++i) {
+      cleaner_threads_.emplace_back([this, i]() {
+        PinCleanerIfNeeded(i);
+        std::array<Clock_t::time_point, kTargetNum> cleared{};
+        for (size_t pass = 0; true;) {
+          {
+            std::unique_lock lock{gc_mtx_};
+            cleaner_cv_.wait(lock, [&]() {
+              return pass != gc_pass_ || !gc_is_running_.load(std::memory_order_relaxed);
+            });
+            if (!gc_is_running_.load(std::memory_order_relaxed)) break;
+            pass = gc_pass_;
+          }
+
+          // release unprotected garbage
+          if (ClearGarbageInShards(i, SnapshotIntervals(), cleared)) {
+            has_garbage_.store(true, std::memory_order_relaxed);
+          }
+        }
+      });
+    }
+
+    // manage the global epoch
+    for (auto interval = gc_interval_; gc_is_running_.load(std::memory_order_relaxed);) {
+      {
+        std::unique_lock lock{gc_mtx_};
+        gc_cv_.wait_for(lock, interval, [&]() {
+          return gc_requested_.load(std::memory_order_relaxed)
+                 || !gc_is_running_.load(std::memory_order_relaxed);
+        });
+      }
+      const auto requested = gc_requested_.exchange(false, std::memory_order_relaxed);
       epoch_manager_.ForwardGlobalEpoch();
+
+      // wake up cleaner threads
+      {
+        std::lock_guard guard{gc_mtx_};
+        ++gc_pass_;
+      }
+      cleaner_cv_.notify_all();
+
+      // back off if there is no garbage
+      if (requested || has_garbage_.exchange(false, std::memory_order_relaxed)) {
+        interval = gc_interval_;
+      } else if (interval < gc_interval_ * kMaxBackoff) {
+        interval *= 2;
+      }
     }
 
     // wait all the cleaner threads return
+    {
+      std::lock_guard guard{gc_mtx_};
+    }
+    cleaner_cv_.notify_all();
     for (auto &&t : cleaner_threads_) {
       t.join();
     }
@@ -470,6 +2572,12 @@ class EpochBasedGC
   /// @brief The maximum number of cleaner threads
   const size_t gc_thread_num_{1};
 
+  /// @brief The number of garbage added by each thread to trigger GC.
+  const size_t gc_watermark_{0};
+
+  /// @brief The number of NUMA nodes (i.e., pmemobj pools for GC).
+  const size_t node_num_{1};
+
   /// @brief An epoch manager.
   ::dbgroup::thread::EpochManager epoch_manager_{};
 
@@ -479,18 +2587,88 @@ class EpochBasedGC
   /// @brief Worker threads to release garbage
   std::vector<std::thread> cleaner_threads_{};
 
+  /// @brief Ranges of thread IDs for each cleaner thread.
+  std::unique_ptr<Shard[]> shards_{};
+
+  /// @brief Pools for sharing destructed pages among threads for each node and
+  /// target.
+  std::vector<std::unique_ptr<component::SharedPagePool>> shared_pools_{};
+
+  /// @brief Bitmaps of lists that have garbage for each node, target, and size
+  /// class.
+  std::unique_ptr<std::atomic_uint64_t[]> active_lists_{};
+
+  /// @brief Flags for indicating lists have been bound to chunks of
+  /// thread-local fields for each node, target, and chunk.
+  std::unique_ptr<std::atomic_bool[]> bound_chunks_{};
+
+  /// @brief A mutex for binding lists to chunks of thread-local fields.
+  std::mutex bind_mtx_{};
+
   /// @brief A flag to check whether garbage collection is running.
   std::atomic_bool gc_is_running_{false};
 
-  /// @brief The heads of linked lists for each GC target.
+  /// @brief A flag for requesting the GC thread to forward the global epoch.
+  std::atomic_bool gc_requested_{false};
+
+  /// @brief A flag for indicating cleaner threads have found garbage.
+  std::atomic_bool has_garbage_{false};
+
+  /// @brief A mutex for waking up the GC and cleaner threads.
+  std::mutex gc_mtx_{};
+
+  /// @brief A condition variable for waking up the GC thread.
+  std::condition_variable gc_cv_{};
+
+  /// @brief A condition variable for waking up cleaner threads (and client
+  /// threads waiting for the next epoch).
+  std::condition_variable cleaner_cv_{};
+
+  /// @brief The number of GC passes (protected by `gc_mtx_`).
+  size_t gc_pass_{0};
+
+  /// @brief The states of reentrant and interval guards for each chunk of
+  /// thread IDs (allocated when a thread in the chunk creates a guard first).
+  std::unique_ptr<std::atomic<GuardChunk *>[]> guard_chunks_{
+      new std::atomic<GuardChunk *>[kWordNum]{}};
+
+  /// @brief The thread ID next to the largest one that has used interval guards.
+  std::atomic_size_t interval_end_{0};
+
+  /// @brief The heads of linked lists in chunks of thread IDs for each GC target
+  /// and node.
   decltype(ConvToTuple<DefaultTarget, GCTargets...>()) garbage_lists_ =
       ConvToTuple<DefaultTarget, GCTargets...>();
 
-  /// @brief The pmemobj_pool for holding garbage lists.
-  PMEMobjpool *pop_{nullptr};
+  /// @brief The final statistics of destroyed garbage lists for each target.
+  std::array<Stats, kTargetNum> retired_stats_{};
+
+  /// @brief Statistics of crash recovery in construction.
+  RecoveryInfo recovery_info_{};
+
+  /// @brief Detached garbage lists to be released in the background.
+  std::vector<RecoveryTask> recovery_tasks_{};
+
+  /// @brief A thread to release detached garbage lists.
+  std::thread recovery_thread_{};
+
+  /// @brief A flag for indicating left garbage lists have been released.
+  std::atomic_bool is_recovered_{false};
+
+  /// @brief A mutex for waiting background recovery.
+  std::mutex recovery_mtx_{};
+
+  /// @brief A condition variable for waiting background recovery.
+  std::condition_variable recovery_cv_{};
+
+  /// @brief The pmemobj_pools for holding garbage lists of each node.
+  std::vector<PMEMobjpool *> pops_{};
+
+  /// @brief The root objects for accessing garbage lists of each node.
+  std::vector<PMEMoid *> roots_{};
 
-  /// @brief The root object for accessing each garbage list.
-  PMEMoid *root_{nullptr};
+  /// @brief A flag for indicating this instance has opened `pops_` by itself.
+  bool owns_pools_{true};
 };
 
 }  // namespace dbgroup::pmem::memory
@@ -18,11 +18,13 @@
 #define PMEM_MEMORY_UTILITY_HPP
 
 // C++ standard libraries
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
 
 // external system libraries
+#include <libpmem.h>
 #include <libpmemobj.h>
 
 namespace dbgroup::pmem::memory
@@ -37,6 +39,9 @@ constexpr size_t kDefaultGCTime = 100000;
 /// @brief The default number of worker threads for garbage collection.
 constexpr size_t kDefaultGCThreadNum = 1;
 
+/// @brief The default number of garbage to trigger GC (zero disables it).
+constexpr size_t kDefaultGCWatermark = 0;
+
 /// @brief The size of words.
 constexpr size_t kWordSize = 8;
 
@@ -85,8 +90,109 @@ struct DefaultTarget {
 
   /// @brief Do not reuse pages after GC (release immediately).
   static constexpr bool kReusePages = false;
+
+  /// @brief Release garbage one by one (do not use PMDK action batches).
+  static constexpr bool kReleaseInBatch = false;
+
+  /// @brief Do not share destructed pages among threads.
+  static constexpr size_t kSharedPoolCapacity = 0;
+
+  /// @brief Reuse pages without distinguishing their sizes.
+  static constexpr std::array<size_t, 1> kPageSizes = {0};
+
+  /// @brief Do not recycle drained garbage lists.
+  static constexpr size_t kSpareListNum = 0;
+
+  /// @brief Store full PMEMoids in garbage lists (i.e., garbage may be in any
+  /// pool).
+  static constexpr bool kCompactSlots = false;
+
+  /// @brief Keep garbage lists in persistent memory (if false, garbage is given
+  /// as pointers to DRAM and released without persistence).
+  static constexpr bool kOnPMEM = true;
+
+  /// @brief The number of garbage lists of each thread to reclaim its own
+  /// garbage in `AddGarbage` (zero disables it).
+  static constexpr size_t kSoftListQuota = 0;
+
+  /// @brief The number of garbage lists of each thread to block `AddGarbage`
+  /// until cleaner threads catch up (zero disables it).
+  static constexpr size_t kHardListQuota = 0;
+
+  /// @brief The number of pages reserved at once by `Allocate` for each thread
+  /// (zero allocates pages one by one).
+  static constexpr size_t kMagazineSize = 0;
+
+  /// @brief The minimum interval of cleaners for this target in microseconds (zero
+  /// clears garbage in every pass of GC).
+  static constexpr size_t kGCIntervalMicroSec = 0;
+
+  /// @brief The priority of this target in each pass of GC (cleaners release
+  /// targets of higher priorities first).
+  static constexpr size_t kGCPriority = 0;
+
+  /// @brief Use birth epochs of garbage along with their retire epochs so that
+  /// interval guards only protect garbage alive in their intervals.
+  static constexpr bool kIntervalBased = false;
+
+  /// @brief The number of garbage pages prefetched ahead of destruction by
+  /// cleaner threads (zero disables it).
+  static constexpr size_t kPrefetchDistance = 0;
 };
 
+/*##############################################################################
+ * Persistence primitives
+ *############################################################################*/
+
+/**
+ * @brief Flush cache lines of a given region.
+ *
+ * @param addr The begin address of a target region.
+ * @param len The length of a target region.
+ * @note If caches are in the persistence domain (`PMEM_MANAGER_USE_EADR`) or
+ * persistence is not required (`PMEM_MANAGER_NO_PERSIST`), this is a no-op.
+ */
+inline void
+Flush(  //
+    [[maybe_unused]] const void *addr,
+    [[maybe_unused]] const size_t len)
+{
+#if !defined(PMEM_MANAGER_USE_EADR) && !defined(PMEM_MANAGER_NO_PERSIST)
+  pmem_flush(addr, len);
+#endif
+}
+
+/**
+ * @brief Wait for flushed cache lines to reach the persistence domain.
+ *
+ * @note If persistence is not required (`PMEM_MANAGER_NO_PERSIST`), this only
+ * prevents compilers from reordering stores.
+ */
+inline void
+Drain()
+{
+#ifndef PMEM_MANAGER_NO_PERSIST
+  pmem_drain();
+#else
+  std::atomic_signal_fence(kRelease);
+#endif
+}
+
+/**
+ * @brief Make a given region durable.
+ *
+ * @param addr The begin address of a target region.
+ * @param len The length of a target region.
+ */
+inline void
+Persist(  //
+    const void *addr,
+    const size_t len)
+{
+  Flush(addr, len);
+  Drain();
+}
+
 /*##############################################################################
  * Utility functions
  *############################################################################*/
@@ -115,6 +221,26 @@ void Zalloc(  //
     PMEMoid *oid,
     const size_t size);
 
+/**
+ * @return The NUMA node of the CPU on which the current thread first called
+ * this function.
+ * @note The result is cached in a thread-local variable, and so threads should
+ * be pinned to CPUs for NUMA-aware placement.
+ */
+auto GetCurrentNode()  //
+    -> size_t;
+
+/**
+ * @brief Pin the current thread to the CPUs of a given NUMA node.
+ *
+ * @param node The ID of a NUMA node.
+ * @retval true if the affinity of the current thread is updated.
+ * @retval false if the node does not exist or has no CPUs.
+ */
+auto PinCurrentThread(  //
+    size_t node)        //
+    -> bool;
+
 }  // namespace dbgroup::pmem::memory
 
 #endif  // PMEM_MEMORY_UTILITY_HPP
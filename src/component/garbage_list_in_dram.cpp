@@ -18,9 +18,11 @@
 #include "pmem/memory/component/garbage_list_in_dram.hpp"
 
 // C++ standard libraries
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 
 // external system libraries
 #include <libpmemobj.h>
@@ -31,6 +33,15 @@
 
 namespace dbgroup::pmem::memory::component
 {
+/*##############################################################################
+ * Public destructors
+ *############################################################################*/
+
+GarbageListInDRAM::~GarbageListInDRAM()
+{
+  delete[] births_.load(kRelaxed);
+}
+
 /*##############################################################################
  * Public APIs
  *############################################################################*/
@@ -44,12 +55,36 @@ GarbageListInDRAM::Empty() const  //
   return (size == 0) && (end_pos < kBufferSize);
 }
 
+void
+GarbageListInDRAM::SetBirth(  //
+    const size_t birth)
+{
+  auto *births = births_.load(kRelaxed);
+  if (births == nullptr) {
+    // publish the array to cleaners that check it concurrently
+    births = new size_t[kBufferSize]{};
+    births_.store(births, kRelease);
+  }
+  births[end_pos_.load(kRelaxed)] = birth;
+}
+
+void
+GarbageListInDRAM::Reset()
+{
+  begin_pos_.store(0, kRelaxed);
+  mid_pos_.store(0, kRelaxed);
+  end_pos_.store(0, kRelaxed);
+  next_.store(0, kRelaxed);
+}
+
 void
 GarbageListInDRAM::AddGarbage(  //
     GarbageListInPMEM **list_addr,
     const size_t epoch,
     PMEMoid *garbage,
-    PMEMobjpool *pop)
+    PMEMobjpool *pop,
+    ListStats *stats,
+    PMEMoid *spare_addr)
 {
   auto *pmem = *list_addr;
   auto *dram = pmem->dram;
@@ -57,15 +92,56 @@ GarbageListInDRAM::AddGarbage(  //
   const auto pos = dram->end_pos_.load(kRelaxed);
   dram->epochs_[pos] = epoch;
   pmem->AddGarbage(pos, garbage);
+  ListStats::Add(stats->persist_num);
   if (pos == kBufferSize - 1) {
-    auto *new_tail = pmem->CreateNextList(pop);
+    auto *new_tail = pmem->CreateNextList(pop, spare_addr);
     dram->next_.store(reinterpret_cast<uintptr_t>(new_tail), kRelaxed);
-    new_tail->dram = new GarbageListInDRAM{};
+    if (new_tail->dram == nullptr) {  // the list is not recycled
+      new_tail->dram = new GarbageListInDRAM{};
+    }
     *list_addr = new_tail;
+    ListStats::Add(stats->created_lists);
   }
   dram->end_pos_.fetch_add(1, kRelease);
 }
 
+void
+GarbageListInDRAM::AddGarbages(  //
+    GarbageListInPMEM **list_addr,
+    const size_t epoch,
+    PMEMoid *garbages,
+    size_t n,
+    PMEMobjpool *pop,
+    ListStats *stats,
+    PMEMoid *spare_addr)
+{
+  while (n > 0) {
+    auto *pmem = *list_addr;
+    auto *dram = pmem->dram;
+
+    const auto pos = dram->end_pos_.load(kRelaxed);
+    const auto cnt = std::min(n, kBufferSize - pos);
+    for (size_t i = 0; i < cnt; ++i) {
+      dram->epochs_[pos + i] = epoch;
+    }
+    pmem->AddGarbages(pos, garbages, cnt);
+    ListStats::Add(stats->persist_num);
+    if (pos + cnt == kBufferSize) {
+      auto *new_tail = pmem->CreateNextList(pop, spare_addr);
+      dram->next_.store(reinterpret_cast<uintptr_t>(new_tail), kRelaxed);
+      if (new_tail->dram == nullptr) {  // the list is not recycled
+        new_tail->dram = new GarbageListInDRAM{};
+      }
+      *list_addr = new_tail;
+      ListStats::Add(stats->created_lists);
+    }
+    dram->end_pos_.fetch_add(cnt, kRelease);
+
+    garbages += cnt;
+    n -= cnt;
+  }
+}
+
 void
 GarbageListInDRAM::ReusePage(  //
     GarbageListInPMEM **list_addr,
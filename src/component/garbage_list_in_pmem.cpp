@@ -18,9 +18,14 @@
 #include "pmem/memory/component/garbage_list_in_pmem.hpp"
 
 // C++ standard libraries
+#include <algorithm>
 #include <atomic>
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
 
 // external system libraries
 #include <libpmem.h>
@@ -39,6 +44,67 @@ namespace
 /// @brief The zero acts as nullptr.
 constexpr uint64_t kNullOffset = 0;
 
+/// @brief The number of actions for moving a list.
+constexpr size_t kMoveActionNum = 4;
+
+/// @brief The number of actions for detaching lists from their head.
+constexpr size_t kDetachActionNum = 3;
+
+/// @brief The number of actions for pushing a list to a stack.
+constexpr size_t kPushActionNum = 5;
+
+/// @brief The number of actions for releasing and unlinking a list.
+constexpr size_t kUnlinkActionNum = 2;
+
+/// @brief The number of actions for releasing and clearing an offset.
+constexpr size_t kReleaseActionNum = 2;
+
+/// @brief The size of header fields in a garbage list.
+constexpr size_t kListHeaderSize = 48;
+
+/// @brief The size of a compact list (offsets, a pool UUID, and padding).
+constexpr size_t kCompactListSize =
+    kListHeaderSize + sizeof(uint64_t) * (::dbgroup::pmem::memory::kBufferSize + 1) + 24;
+
+/*##############################################################################
+ * Local utilities
+ *############################################################################*/
+
+/**
+ * @brief Check that given PMEMoids can be stored in a compact list.
+ *
+ * @param uuid The pool UUID of a compact list.
+ * @param garbages PMEMoids to be written to the list.
+ * @param n The number of PMEMoids.
+ * @throws std::runtime_error if any PMEMoid is in another pool.
+ */
+void
+CheckPoolUUIDs(  //
+    const uint64_t uuid,
+    const PMEMoid *garbages,
+    const size_t n)
+{
+  for (size_t i = 0; i < n; ++i) {
+    if (garbages[i].pool_uuid_lo != uuid) {
+      throw std::runtime_error{"garbage of compact lists must be in a single pool."};
+    }
+  }
+}
+
+/**
+ * @retval true if the first PMEMoid is less than the second one.
+ * @retval false otherwise.
+ */
+auto
+CompOIDs(  //
+    const PMEMoid &lhs,
+    const PMEMoid &rhs)  //
+    -> bool
+{
+  return lhs.pool_uuid_lo < rhs.pool_uuid_lo
+         || (lhs.pool_uuid_lo == rhs.pool_uuid_lo && lhs.off < rhs.off);
+}
+
 }  // namespace
 
 namespace dbgroup::pmem::memory::component
@@ -56,45 +122,223 @@ GarbageListInPMEM::ExchangeHead(  //
 {
   *tmp_addr = *head_addr;
   head_addr->off = list->next.off;
-  pmem_persist(head_addr, 2 * sizeof(PMEMoid));  // in the same cache line
+  Persist(head_addr, 2 * sizeof(PMEMoid));  // in the same cache line
 
   pmemobj_free(tmp_addr);
   return static_cast<GarbageListInPMEM *>(pmemobj_direct(*head_addr));
 }
 
-void
+auto
 GarbageListInPMEM::ReleaseAllGarbages(  //
-    TLSFields *tls)
+    TLSFields *tls)                     //
+    -> size_t
 {
-  if (OID_IS_NULL(tls->head)) return;
-  if (!OID_IS_NULL(tls->tmp_head)) {
-    if (OID_EQUALS(tls->tmp_head, tls->head)) {
-      tls->tmp_head = OID_NULL;
-      pmem_persist(&(tls->tmp_head), sizeof(PMEMoid));
+  return ReleaseAllGarbages(&(tls->head), &(tls->tmp_head), tls);
+}
+
+auto
+GarbageListInPMEM::ReleaseAllGarbages(  //
+    PMEMoid *head,
+    PMEMoid *tmp_head,
+    TLSFields *tls)  //
+    -> size_t
+{
+  if (OID_IS_NULL(*head)) return 0;
+  if (!OID_IS_NULL(*tmp_head)) {
+    if (OID_EQUALS(*tmp_head, *head)) {
+      *tmp_head = OID_NULL;
+      Persist(tmp_head, sizeof(PMEMoid));
     } else {
-      pmemobj_free(&(tls->tmp_head));
+      pmemobj_free(tmp_head);
     }
   }
 
-  auto *buf = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(tls->head));
+  size_t cnt = 0;
+  auto *buf = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*head));
   while (true) {
     if (!OID_IS_NULL(buf->tmp)) {
       if (OID_EQUALS(buf->tmp, buf->next)) {
         buf->tmp = OID_NULL;
-        pmem_persist(&(buf->tmp), sizeof(PMEMoid));
+        Persist(&(buf->tmp), sizeof(PMEMoid));
       } else {
         pmemobj_free(&(buf->tmp));
       }
     }
     for (size_t i = 0; i < kBufferSize; ++i) {
-      auto *oid = &(buf->garbages_[i]);
-      if (oid->pool_uuid_lo == 0 || oid->off == 0 || tls->HasSamePMEMoid(*oid)) continue;
-      pmemobj_free(oid);
+      const auto &oid = buf->GetGarbage(i);
+      if (oid.pool_uuid_lo == 0 || oid.off == 0 || tls->HasSamePMEMoid(oid)) continue;
+      buf->ReleaseGarbage(i);
+      ++cnt;
     }
     if (OID_IS_NULL(buf->next)) break;
-    buf = ExchangeHead(buf, &(tls->head), &(tls->tmp_head));
+    buf = ExchangeHead(buf, head, tmp_head);
+  }
+  pmemobj_free(head);
+  return cnt;
+}
+
+auto
+GarbageListInPMEM::ReleaseAllGarbages(  //
+    TLSFields *tls,
+    const std::vector<const TLSFields *> &others)  //
+    -> size_t
+{
+  if (OID_IS_NULL(tls->head)) return 0;
+
+  // collect PMEMoids that may be reused by other threads
+  std::vector<PMEMoid> reused{};
+  for (const auto *other : others) {
+    for (const auto &oid : other->tmp_oids) {
+      if (OID_IS_NULL(oid)) continue;
+      reused.emplace_back(oid);
+    }
+  }
+  std::sort(reused.begin(), reused.end(), CompOIDs);
+
+  // remove the reused PMEMoids from the list before releasing
+  for (auto *buf = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(tls->head));  //
+       buf != nullptr;                                                                //
+       buf = buf->GetNext()) {
+    for (size_t i = 0; i < kBufferSize; ++i) {
+      const auto &oid = buf->GetGarbage(i);
+      if (oid.pool_uuid_lo == 0 || oid.off == 0) continue;
+      if (!std::binary_search(reused.begin(), reused.end(), oid, CompOIDs)) continue;
+      auto *off = buf->GetOffAddr(i);
+      *off = kNullOffset;
+      Persist(off, kWordSize);
+    }
+  }
+  return ReleaseAllGarbages(tls);
+}
+
+auto
+GarbageListInPMEM::DetachAllGarbages(  //
+    PMEMoid *head,
+    PMEMoid *tmp_head,
+    const TLSFields *tls,
+    TLSFields *dest)  //
+    -> bool
+{
+  if (!OID_IS_NULL(*tmp_head)) {
+    if (OID_EQUALS(*tmp_head, *head)) {
+      *tmp_head = OID_NULL;
+      Persist(tmp_head, sizeof(PMEMoid));
+    } else {
+      pmemobj_free(tmp_head);
+    }
+  }
+
+  // keep the temporary fields because the owner thread will overwrite them
+  std::memcpy(dest->tmp_oids, tls->tmp_oids, sizeof(PMEMoid) * kTmpFieldNum);
+  Persist(dest->tmp_oids, sizeof(PMEMoid) * kTmpFieldNum);
+
+  return MoveAllLists(head, &(dest->head));
+}
+
+auto
+GarbageListInPMEM::MoveList(  //
+    PMEMoid *src_addr,
+    PMEMoid *dest_addr)  //
+    -> bool
+{
+  auto *list = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*src_addr));
+  auto *pop = pmemobj_pool_by_ptr(list);
+  const auto uuid = src_addr->pool_uuid_lo;
+  const auto off = src_addr->off;
+
+  pobj_action acts[kMoveActionNum];
+  pmemobj_set_value(pop, &(acts[0]), &(src_addr->off), list->next.off);
+  pmemobj_set_value(pop, &(acts[1]), &(dest_addr->pool_uuid_lo), uuid);
+  pmemobj_set_value(pop, &(acts[2]), &(dest_addr->off), off);
+  pmemobj_set_value(pop, &(acts[3]), &(list->next.off), kNullOffset);
+  if (pmemobj_publish(pop, acts, kMoveActionNum) != 0) {
+    pmemobj_cancel(pop, acts, kMoveActionNum);
+    return false;
+  }
+  return true;
+}
+
+auto
+GarbageListInPMEM::PushList(  //
+    PMEMoid *src_addr,
+    PMEMoid *stack_addr)  //
+    -> bool
+{
+  auto *list = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*src_addr));
+  auto *pop = pmemobj_pool_by_ptr(list);
+  const auto uuid = src_addr->pool_uuid_lo;
+  const auto off = src_addr->off;
+
+  pobj_action acts[kPushActionNum];
+  pmemobj_set_value(pop, &(acts[0]), &(src_addr->off), list->next.off);
+  pmemobj_set_value(pop, &(acts[1]), &(list->next.pool_uuid_lo), uuid);
+  pmemobj_set_value(pop, &(acts[2]), &(list->next.off), stack_addr->off);
+  pmemobj_set_value(pop, &(acts[3]), &(stack_addr->pool_uuid_lo), uuid);
+  pmemobj_set_value(pop, &(acts[4]), &(stack_addr->off), off);
+  if (pmemobj_publish(pop, acts, kPushActionNum) != 0) {
+    pmemobj_cancel(pop, acts, kPushActionNum);
+    return false;
+  }
+  return true;
+}
+
+auto
+GarbageListInPMEM::MoveAllLists(  //
+    PMEMoid *src_addr,
+    PMEMoid *dest_addr)  //
+    -> bool
+{
+  auto *pop = pmemobj_pool_by_oid(*src_addr);
+  pobj_action acts[kDetachActionNum];
+  pmemobj_set_value(pop, &(acts[0]), &(dest_addr->pool_uuid_lo), src_addr->pool_uuid_lo);
+  pmemobj_set_value(pop, &(acts[1]), &(dest_addr->off), src_addr->off);
+  pmemobj_set_value(pop, &(acts[2]), &(src_addr->off), kNullOffset);
+  if (pmemobj_publish(pop, acts, kDetachActionNum) != 0) {
+    pmemobj_cancel(pop, acts, kDetachActionNum);
+    return false;
+  }
+  return true;
+}
+
+void
+GarbageListInPMEM::ReleaseEmptyLists(  //
+    PMEMoid *head_addr)
+{
+  while (!OID_IS_NULL(*head_addr)) {
+    auto *list = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*head_addr));
+    auto *pop = pmemobj_pool_by_ptr(list);
+
+    pobj_action acts[kUnlinkActionNum];
+    pmemobj_defer_free(pop, *head_addr, &(acts[0]));
+    pmemobj_set_value(pop, &(acts[1]), &(head_addr->off), list->next.off);
+    if (pmemobj_publish(pop, acts, kUnlinkActionNum) != 0) {
+      pmemobj_cancel(pop, acts, kUnlinkActionNum);
+      return;  // the remaining lists are released in the next call
+    }
+  }
+}
+
+void
+GarbageListInPMEM::CreateList(  //
+    PMEMobjpool *pop,
+    PMEMoid *list_addr,
+    const bool compact)
+{
+  if (!compact) {
+    Zalloc(pop, list_addr, sizeof(GarbageListInPMEM));
+    return;
+  }
+
+  // mark the list in the constructor to publish it with the allocation
+  auto &&init = [](PMEMobjpool *, void *ptr, void *) -> int {
+    std::memset(ptr, 0, kCompactListSize);
+    reinterpret_cast<GarbageListInPMEM *>(ptr)->compact = 1;
+    Persist(ptr, kCompactListSize);
+    return 0;
+  };
+  if (pmemobj_alloc(pop, list_addr, kCompactListSize, kPMDKNullType, init, nullptr) != 0) {
+    throw std::runtime_error{pmemobj_errormsg()};
   }
-  pmemobj_free(&(tls->head));
 }
 
 void
@@ -102,14 +346,64 @@ GarbageListInPMEM::AddGarbage(  //
     const size_t pos,
     PMEMoid *garbage)
 {
-  garbages_[pos].pool_uuid_lo = garbage->pool_uuid_lo;
-  std::atomic_thread_fence(std::memory_order_acq_rel);
-  garbages_[pos].off = garbage->off;
-  pmem_flush(&garbages_[pos], sizeof(PMEMoid));
+  if (compact) {
+    auto *offsets = GetOffsets();
+    if (pos == 0) {
+      // the pool UUID must be durable before any offset
+      offsets[kBufferSize] = garbage->pool_uuid_lo;
+      Persist(&(offsets[kBufferSize]), kWordSize);
+    } else {
+      CheckPoolUUIDs(offsets[kBufferSize], garbage, 1);
+    }
+    offsets[pos] = garbage->off;
+    Flush(&(offsets[pos]), kWordSize);
+  } else {
+    garbages_[pos].pool_uuid_lo = garbage->pool_uuid_lo;
+    std::atomic_thread_fence(std::memory_order_acq_rel);
+    garbages_[pos].off = garbage->off;
+    Flush(&garbages_[pos], sizeof(PMEMoid));
+  }
   std::atomic_thread_fence(std::memory_order_acq_rel);
 
   garbage->off = kNullOffset;
-  pmem_persist(&(garbage->off), kWordSize);
+  Persist(&(garbage->off), kWordSize);
+}
+
+void
+GarbageListInPMEM::AddGarbages(  //
+    const size_t pos,
+    PMEMoid *garbages,
+    const size_t n)
+{
+  if (compact) {
+    auto *offsets = GetOffsets();
+    CheckPoolUUIDs(pos == 0 ? garbages[0].pool_uuid_lo : offsets[kBufferSize], garbages, n);
+    if (pos == 0) {
+      // the pool UUID must be durable before any offset
+      offsets[kBufferSize] = garbages[0].pool_uuid_lo;
+      Persist(&(offsets[kBufferSize]), kWordSize);
+    }
+    for (size_t i = 0; i < n; ++i) {
+      offsets[pos + i] = garbages[i].off;
+    }
+    Flush(&(offsets[pos]), kWordSize * n);
+  } else {
+    auto *slots = &(garbages_[pos]);
+    for (size_t i = 0; i < n; ++i) {
+      slots[i].pool_uuid_lo = garbages[i].pool_uuid_lo;
+    }
+    std::atomic_thread_fence(std::memory_order_acq_rel);
+    for (size_t i = 0; i < n; ++i) {
+      slots[i].off = garbages[i].off;
+    }
+    Flush(slots, sizeof(PMEMoid) * n);
+  }
+  Drain();
+
+  for (size_t i = 0; i < n; ++i) {
+    garbages[i].off = kNullOffset;
+  }
+  Persist(garbages, sizeof(PMEMoid) * n);
 }
 
 void
@@ -117,21 +411,103 @@ GarbageListInPMEM::ReusePage(  //
     const size_t pos,
     PMEMoid *out_page)
 {
-  out_page->pool_uuid_lo = garbages_[pos].pool_uuid_lo;
+  const auto &page = GetGarbage(pos);
+  out_page->pool_uuid_lo = page.pool_uuid_lo;
   std::atomic_thread_fence(std::memory_order_acq_rel);
-  out_page->off = garbages_[pos].off;
-  pmem_flush(out_page, sizeof(PMEMoid));
+  out_page->off = page.off;
+  Flush(out_page, sizeof(PMEMoid));
   std::atomic_thread_fence(std::memory_order_acq_rel);
 
-  garbages_[pos].off = kNullOffset;
-  pmem_persist(&(garbages_[pos].off), kWordSize);
+  auto *off = GetOffAddr(pos);
+  *off = kNullOffset;
+  Persist(off, kWordSize);
 }
 
 void
 GarbageListInPMEM::ReleaseGarbage(  //
     const size_t pos)
 {
-  pmemobj_free(&(garbages_[pos]));
+  if (!compact) {
+    pmemobj_free(&(garbages_[pos]));
+    return;
+  }
+
+  auto *off = GetOffAddr(pos);
+  auto oid = GetGarbage(pos);
+  if (oid.off == kNullOffset) return;
+  auto *pop = pmemobj_pool_by_oid(oid);
+  if (pop == pmemobj_pool_by_ptr(this)) {
+    // release the garbage and clear its offset atomically
+    pobj_action acts[kReleaseActionNum];
+    pmemobj_defer_free(pop, oid, &(acts[0]));
+    pmemobj_set_value(pop, &(acts[1]), off, kNullOffset);
+    if (pmemobj_publish(pop, acts, kReleaseActionNum) == 0) return;
+    pmemobj_cancel(pop, acts, kReleaseActionNum);
+  }
+
+  // a machine failure after this may leak garbage but not free them doubly
+  *off = kNullOffset;
+  Persist(off, kWordSize);
+  pmemobj_free(&oid);
+}
+
+void
+GarbageListInPMEM::ReleaseGarbages(  //
+    const size_t begin_pos,
+    const size_t end_pos)
+{
+  auto *own_pop = pmemobj_pool_by_ptr(this);
+  pobj_action acts[2 * kBufferSize];
+  PMEMoid oids[kBufferSize];
+
+  const auto slot_size = compact ? kWordSize : sizeof(PMEMoid);
+  for (auto pos = begin_pos; pos < end_pos;) {
+    if (OID_IS_NULL(GetGarbage(pos))) {
+      ++pos;
+      continue;
+    }
+
+    // collect consecutive garbage in the same pool
+    auto *pop = pmemobj_pool_by_oid(GetGarbage(pos));
+    const auto begin = pos;
+    size_t n = 0;
+    for (; pos < end_pos; ++pos) {
+      const auto &oid = GetGarbage(pos);
+      if (OID_IS_NULL(oid)) continue;
+      if (pmemobj_pool_by_oid(oid) != pop) break;
+      oids[n] = oid;
+      pmemobj_defer_free(pop, oids[n], &(acts[n]));
+      ++n;
+    }
+
+    auto act_num = n;
+    if (pop == own_pop) {
+      // clear the slots in the same batch
+      for (auto i = begin; i < pos; ++i) {
+        if (OID_IS_NULL(GetGarbage(i))) continue;
+        pmemobj_set_value(pop, &(acts[act_num++]), GetOffAddr(i), kNullOffset);
+      }
+    } else {
+      // a machine failure after this may leak garbage but not free them doubly
+      for (auto i = begin; i < pos; ++i) {
+        *GetOffAddr(i) = kNullOffset;
+      }
+      Persist(GetOffAddr(begin), slot_size * (pos - begin));
+    }
+    if (pmemobj_publish(pop, acts, act_num) == 0) continue;
+
+    // fall back to releasing garbage one by one
+    pmemobj_cancel(pop, acts, act_num);
+    if (pop == own_pop) {
+      for (auto i = begin; i < pos; ++i) {
+        ReleaseGarbage(i);
+      }
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        pmemobj_free(&(oids[i]));
+      }
+    }
+  }
 }
 
 auto
@@ -143,10 +519,13 @@ GarbageListInPMEM::GetNext() const  //
 
 auto
 GarbageListInPMEM::CreateNextList(  //
-    PMEMobjpool *pop)               //
+    PMEMobjpool *pop,
+    PMEMoid *spare_addr)  //
     -> GarbageListInPMEM *
 {
-  Zalloc(pop, &next, sizeof(GarbageListInPMEM));
+  if (spare_addr == nullptr || OID_IS_NULL(*spare_addr) || !MoveList(spare_addr, &next)) {
+    CreateList(pop, &next, compact != 0);
+  }
   return GetNext();
 }
 
@@ -155,5 +534,7 @@ GarbageListInPMEM::CreateNextList(  //
  *############################################################################*/
 
 static_assert((kPMDKHeaderSize + sizeof(GarbageListInPMEM)) % kCacheLineSize == 0);
+static_assert(kListHeaderSize + sizeof(PMEMoid) * kBufferSize == sizeof(GarbageListInPMEM));
+static_assert((kPMDKHeaderSize + kCompactListSize) % kCacheLineSize == 0);
 
 }  // namespace dbgroup::pmem::memory::component
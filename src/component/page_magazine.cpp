@@ -0,0 +1,117 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "pmem/memory/component/page_magazine.hpp"
+
+// C++ standard libraries
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+// external system libraries
+#include <libpmemobj.h>
+
+// local sources
+#include "pmem/memory/utility.hpp"
+
+namespace dbgroup::pmem::memory::component
+{
+/*##############################################################################
+ * Public constructors/destructors
+ *############################################################################*/
+
+PageMagazine::PageMagazine(  //
+    const size_t capacity)
+    : capacity_{capacity},
+      acts_{std::make_unique<pobj_action[]>(capacity)},
+      oids_{std::make_unique<PMEMoid[]>(capacity)}
+{
+}
+
+PageMagazine::~PageMagazine()
+{
+  if (num_ > 0) {
+    pmemobj_cancel(pop_, acts_.get(), num_);
+  }
+}
+
+/*##############################################################################
+ * Public utilities
+ *############################################################################*/
+
+void
+PageMagazine::Allocate(  //
+    PMEMobjpool *pop,
+    PMEMoid *out_oid,
+    const size_t size)
+{
+  if (num_ == 0 || pop != pop_ || size != size_) {
+    Refill(pop, size);
+  }
+
+  const auto pos = --num_;
+  const auto &oid = oids_[pos];
+  if (pmemobj_pool_by_ptr(out_oid) != pop_) {
+    // a field out of the pool cannot be published atomically like pmemobj_alloc
+    Publish(&(acts_[pos]), 1);
+    *out_oid = oid;
+    Persist(out_oid, sizeof(PMEMoid));
+    return;
+  }
+
+  // publish the last reservation along with its destination
+  pobj_action acts[kAllocActionNum];
+  acts[0] = acts_[pos];
+  pmemobj_set_value(pop_, &(acts[1]), &(out_oid->pool_uuid_lo), oid.pool_uuid_lo);
+  pmemobj_set_value(pop_, &(acts[2]), &(out_oid->off), oid.off);
+  Publish(acts, kAllocActionNum);
+}
+
+/*##############################################################################
+ * Internal utilities
+ *############################################################################*/
+
+void
+PageMagazine::Publish(  //
+    pobj_action *acts,
+    const size_t n)
+{
+  if (pmemobj_publish(pop_, acts, n) != 0) {
+    pmemobj_cancel(pop_, acts, n);
+    throw std::runtime_error{pmemobj_errormsg()};
+  }
+}
+
+void
+PageMagazine::Refill(  //
+    PMEMobjpool *pop,
+    const size_t size)
+{
+  if (num_ > 0) {
+    pmemobj_cancel(pop_, acts_.get(), num_);
+  }
+
+  pop_ = pop;
+  size_ = size;
+  for (num_ = 0; num_ < capacity_; ++num_) {
+    oids_[num_] = pmemobj_reserve(pop, &(acts_[num_]), size, kPMDKNullType);
+    if (OID_IS_NULL(oids_[num_])) break;
+  }
+  if (num_ == 0) throw std::runtime_error{pmemobj_errormsg()};
+}
+
+}  // namespace dbgroup::pmem::memory::component
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "pmem/memory/component/shared_page_pool.hpp"
+
+// C++ standard libraries
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+// external system libraries
+#include <libpmemobj.h>
+
+// local sources
+#include "pmem/memory/component/garbage_list_in_pmem.hpp"
+#include "pmem/memory/component/tls_fields.hpp"
+#include "pmem/memory/utility.hpp"
+
+namespace dbgroup::pmem::memory::component
+{
+/*##############################################################################
+ * Public constructors/destructors
+ *############################################################################*/
+
+SharedPagePool::SharedPagePool(  //
+    TLSFields *tls,
+    const size_t capacity)
+    : capacity_{(capacity + kBufferSize - 1) / kBufferSize}, tls_{tls}
+{
+}
+
+SharedPagePool::~SharedPagePool()
+{
+  blocks_.clear();
+  GarbageListInPMEM::ReleaseAllGarbages(tls_);
+}
+
+/*##############################################################################
+ * Public APIs
+ *############################################################################*/
+
+auto
+SharedPagePool::Donate(  //
+    PMEMoid *list_addr)  //
+    -> bool
+{
+  std::lock_guard guard{mtx_};
+
+  RemovePoppedBlocks();
+  if (blocks_.size() >= capacity_) return false;
+
+  auto *pmem = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(*list_addr));
+  auto *dest = blocks_.empty() ? &(tls_->head) : &(blocks_.back()->pmem->next);
+  if (!GarbageListInPMEM::MoveList(list_addr, dest)) return false;
+
+  pmem->dram = nullptr;
+  auto block = std::make_unique<Block>();
+  block->pmem = pmem;
+  blocks_.emplace_back(std::move(block));
+  unclaimed_.fetch_add(kBufferSize, kRelease);
+  return true;
+}
+
+void
+SharedPagePool::ReusePage(  //
+    Batch *batch,
+    PMEMoid *out_page)
+{
+  if (batch->pos == batch->end) {
+    if (unclaimed_.load(kAcquire) == 0) return;
+
+    // claim a new batch
+    std::lock_guard guard{mtx_};
+    RemovePoppedBlocks();
+    for (auto &&block : blocks_) {
+      if (block->claimed == kBufferSize) continue;
+      const auto n = std::min(kBatchSize, kBufferSize - block->claimed);
+      batch->block = block.get();
+      batch->begin = block->claimed;
+      batch->pos = block->claimed;
+      batch->end = block->claimed + n;
+      block->claimed += n;
+      unclaimed_.fetch_sub(n, kRelaxed);
+      break;
+    }
+    if (batch->pos == batch->end) return;
+  }
+
+  batch->block->pmem->ReusePage(batch->pos++, out_page);
+  if (batch->pos == batch->end) {
+    batch->block->popped.fetch_add(batch->end - batch->begin, kRelease);
+  }
+}
+
+void
+SharedPagePool::ReleaseBatch(  //
+    Batch *batch)
+{
+  if (batch->pos == batch->end) return;
+
+  for (; batch->pos < batch->end; ++batch->pos) {
+    batch->block->pmem->ReleaseGarbage(batch->pos);
+  }
+  batch->block->popped.fetch_add(batch->end - batch->begin, kRelease);
+}
+
+/*##############################################################################
+ * Internal utilities
+ *############################################################################*/
+
+void
+SharedPagePool::RemovePoppedBlocks()
+{
+  while (!blocks_.empty() && blocks_.front()->popped.load(kAcquire) == kBufferSize) {
+    GarbageListInPMEM::ExchangeHead(blocks_.front()->pmem, &(tls_->head), &(tls_->tmp_head));
+    blocks_.pop_front();
+  }
+}
+
+}  // namespace dbgroup::pmem::memory::component
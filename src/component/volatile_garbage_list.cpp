@@ -0,0 +1,89 @@
+/*
+ * Copyright 2024 Database Group, Nagoya University
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// the corresponding header
+#include "pmem/memory/component/volatile_garbage_list.hpp"
+
+// C++ standard libraries
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// local sources
+#include "pmem/memory/component/list_stats.hpp"
+#include "pmem/memory/utility.hpp"
+
+namespace dbgroup::pmem::memory::component
+{
+/*##############################################################################
+ * Public APIs
+ *############################################################################*/
+
+auto
+VolatileGarbageList::Empty() const  //
+    -> bool
+{
+  const auto end_pos = end_pos_.load(kRelaxed);
+  const auto size = end_pos - begin_pos_.load(kRelaxed);
+  return (size == 0) && (end_pos < kBufferSize);
+}
+
+void
+VolatileGarbageList::AddGarbage(  //
+    VolatileGarbageList **list_addr,
+    const size_t epoch,
+    void *garbage,
+    ListStats *stats)
+{
+  auto *list = *list_addr;
+
+  const auto pos = list->end_pos_.load(kRelaxed);
+  list->epochs_[pos] = epoch;
+  list->garbages_[pos] = garbage;
+  if (pos == kBufferSize - 1) {
+    auto *new_tail = new VolatileGarbageList{};
+    list->gc_next_ = new_tail;
+    list->next_.store(reinterpret_cast<uintptr_t>(new_tail), kRelaxed);
+    *list_addr = new_tail;
+    ListStats::Add(stats->created_lists);
+  }
+  list->end_pos_.fetch_add(1, kRelease);
+}
+
+auto
+VolatileGarbageList::ReusePage(       //
+    VolatileGarbageList **list_addr)  //
+    -> void *
+{
+  auto *list = *list_addr;
+
+  const auto pos = list->begin_pos_.load(kRelaxed);
+  const auto mid_pos = list->mid_pos_.load(kAcquire);
+  if (pos == mid_pos) return nullptr;
+
+  auto *page = list->garbages_[pos];
+  if (pos == kBufferSize - 1) {
+    auto next = list->next_.load(kAcquire);
+    while (!list->next_.compare_exchange_weak(next, next | kUsed, kRelaxed, kAcquire)) {
+      // continue until reading a valid pointer
+    }
+    *list_addr = reinterpret_cast<VolatileGarbageList *>(next);
+  }
+  list->begin_pos_.fetch_add(1, kRelease);
+  return page;
+}
+
+}  // namespace dbgroup::pmem::memory::component
@@ -17,9 +17,16 @@
 // the corresponding header
 #include "pmem/memory/utility.hpp"
 
+// system headers
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
 // C++ standard libraries
 #include <cstddef>
+#include <fstream>
 #include <stdexcept>
+#include <string>
 
 // external system libraries
 #include <libpmemobj.h>
@@ -52,4 +59,48 @@ Zalloc(  //
   }
 }
 
+auto
+GetCurrentNode()  //
+    -> size_t
+{
+  thread_local const size_t node = []() -> size_t {
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return 0;
+    return node;
+  }();
+  return node;
+}
+
+auto
+PinCurrentThread(       //
+    const size_t node)  //
+    -> bool
+{
+  // the list of CPUs is formatted as "0-3,8-11"
+  std::ifstream fin{"/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+  std::string cpu_list{};
+  if (!std::getline(fin, cpu_list)) return false;
+
+  cpu_set_t cpus{};
+  CPU_ZERO(&cpus);
+  for (size_t pos = 0; pos < cpu_list.size();) {
+    auto end = cpu_list.find(',', pos);
+    if (end == std::string::npos) {
+      end = cpu_list.size();
+    }
+    const auto range = cpu_list.substr(pos, end - pos);
+    const auto sep = range.find('-');
+    const auto first = std::stoul(range.substr(0, sep));
+    const auto last = (sep == std::string::npos) ? first : std::stoul(range.substr(sep + 1));
+    for (auto cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu) {
+      CPU_SET(cpu, &cpus);
+    }
+    pos = end + 1;
+  }
+  if (CPU_COUNT(&cpus) == 0) return false;
+
+  return sched_setaffinity(0, sizeof(cpu_set_t), &cpus) == 0;
+}
+
 }  // namespace dbgroup::pmem::memory
@@ -17,12 +17,22 @@
 // the corresponding header
 #include "pmem/memory/epoch_based_gc.hpp"
 
+// system headers
+#include <sys/wait.h>
+#include <unistd.h>
+
 // C++ standard libraries
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
 #include <filesystem>
 #include <future>
 #include <memory>
 #include <mutex>
 #include <random>
+#include <stdexcept>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -66,11 +76,87 @@ class EpochBasedGCFixture : public ::testing::Test
     static constexpr bool kReusePages = true;
   };
 
+  struct BatchReleaseTarget : public DefaultTarget {
+    using T = std::shared_ptr<Target>;
+    static constexpr bool kReleaseInBatch = true;
+    static constexpr size_t kMagazineSize = 16;
+  };
+
+  struct SharedPoolTarget : public DefaultTarget {
+    using T = std::shared_ptr<Target>;
+    static constexpr bool kReusePages = true;
+    static constexpr size_t kSharedPoolCapacity = kBufferSize * 16;
+  };
+
+  struct SizeClassTarget : public DefaultTarget {
+    static constexpr bool kReusePages = true;
+    static constexpr std::array<size_t, 3> kPageSizes = {64, 256, 1024};
+  };
+
+  struct CompactTarget : public DefaultTarget {
+    using T = std::shared_ptr<Target>;
+    static constexpr bool kReusePages = true;
+    static constexpr bool kReleaseInBatch = true;
+    static constexpr bool kCompactSlots = true;
+    static constexpr size_t kPrefetchDistance = 8;
+  };
+
+  struct QuotaTarget : public DefaultTarget {
+    using T = std::shared_ptr<Target>;
+    static constexpr size_t kSoftListQuota = 2;
+    static constexpr size_t kHardListQuota = 4;
+    static constexpr size_t kPrefetchDistance = 8;
+  };
+
+  struct LazyTarget : public DefaultTarget {
+    using T = std::shared_ptr<Target>;
+    static constexpr size_t kGCIntervalMicroSec = 1E8;  // 100 s
+  };
+
+  struct UrgentTarget : public DefaultTarget {
+    using T = std::shared_ptr<Target>;
+    static constexpr size_t kGCPriority = 1;
+  };
+
+  struct IntervalTarget : public DefaultTarget {
+    using T = std::shared_ptr<Target>;
+    static constexpr bool kIntervalBased = true;
+  };
+
+  struct CleanerRecorder {
+    ~CleanerRecorder()
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});  // emulate heavy destructors
+      const std::lock_guard guard{cleaner_mtx_};
+      cleaner_ids_.emplace_back(std::this_thread::get_id());
+    }
+  };
+
+  struct RecordedTarget : public DefaultTarget {
+    using T = CleanerRecorder;
+  };
+
+  struct VolatileTarget : public DefaultTarget {
+    using T = std::shared_ptr<Target>;
+    static constexpr bool kReusePages = true;
+    static constexpr bool kOnPMEM = false;
+  };
+
   /*############################################################################
    * Type aliases
    *##########################################################################*/
 
-  using EpochBasedGC_t = EpochBasedGC<SharedPtrTarget>;
+  using EpochBasedGC_t = EpochBasedGC<SharedPtrTarget,
+                                      BatchReleaseTarget,
+                                      SharedPoolTarget,
+                                      SizeClassTarget,
+                                      CompactTarget,
+                                      QuotaTarget,
+                                      LazyTarget,
+                                      UrgentTarget,
+                                      IntervalTarget,
+                                      RecordedTarget,
+                                      VolatileTarget>;
   using GarbageRef = std::vector<std::weak_ptr<Target>>;
 
   /*############################################################################
@@ -136,6 +222,57 @@ class EpochBasedGCFixture : public ::testing::Test
     p.set_value(std::move(target_weak_ptrs));
   }
 
+  void
+  AddGarbages(  //
+      std::promise<GarbageRef> p,
+      const size_t garbage_num)
+  {
+    GarbageRef target_weak_ptrs;
+    auto *garbages = gc_->GetTmpField<SharedPtrTarget>(0);
+    for (size_t loop = 0; loop < garbage_num; loop += kTmpFieldNum) {
+      const auto cnt = std::min(garbage_num - loop, kTmpFieldNum);
+      for (size_t i = 0; i < cnt; ++i) {
+        Malloc(pop_, &(garbages[i]), sizeof(std::shared_ptr<Target>));
+        auto *target = new Target{0};
+        auto *shared = new (pmemobj_direct(garbages[i])) std::shared_ptr<Target>{target};
+        target_weak_ptrs.emplace_back(*shared);
+      }
+      gc_->AddGarbages<SharedPtrTarget>(garbages, cnt);
+    }
+    p.set_value(std::move(target_weak_ptrs));
+  }
+
+  void
+  AddGarbageInBatchMode(  //
+      std::promise<GarbageRef> p,
+      const size_t garbage_num)
+  {
+    GarbageRef target_weak_ptrs;
+    auto *garbage = gc_->GetTmpField<BatchReleaseTarget>(0);
+    for (size_t loop = 0; loop < garbage_num; ++loop) {
+      Malloc(pop_, garbage, sizeof(std::shared_ptr<Target>));
+      auto *target = new Target{0};
+      auto *shared = new (pmemobj_direct(*garbage)) std::shared_ptr<Target>{target};
+      target_weak_ptrs.emplace_back(*shared);
+      gc_->AddGarbage<BatchReleaseTarget>(garbage);
+    }
+    p.set_value(std::move(target_weak_ptrs));
+  }
+
+  template <class GCTarget>
+  void
+  AddGarbageWithoutReuse(  //
+      GarbageRef *target_weak_ptrs)
+  {
+    auto *garbage = gc_->GetTmpField<GCTarget>(0);
+    for (size_t loop = 0; loop < kGarbageNumSmall; ++loop) {
+      Malloc(pop_, garbage, sizeof(std::shared_ptr<Target>));
+      auto *shared = new (pmemobj_direct(*garbage)) std::shared_ptr<Target>{new Target{0}};
+      target_weak_ptrs->emplace_back(*shared);
+      gc_->AddGarbage<GCTarget>(garbage);
+    }
+  }
+
   void
   KeepEpochGuard(std::promise<Target> p)
   {
@@ -274,45 +411,50 @@ class EpochBasedGCFixture : public ::testing::Test
   }
 
   void
-  VerifyCreateEpochGuard(const size_t thread_num)
+  VerifyAddGarbages(const size_t thread_num)
   {
-    // a lambda function to keep an epoch guard
-    auto create_guard = [&](std::promise<Target> p) {
-      const auto guard = gc_->CreateEpochGuard();
-      p.set_value(0);  // set promise to notice
-      const auto lock = std::unique_lock<std::mutex>{mtx_};
-    };
-
-    // create an epoch guard on anther thread
-    std::thread guarder;
-
-    {
-      // create a lock to keep an epoch guard
-      const auto thread_lock = std::unique_lock<std::mutex>{mtx_};
-
-      // create an epoch guard
-      std::promise<Target> p;
-      auto f = p.get_future();
-      guarder = std::thread{create_guard, std::move(p)};
-      f.get();
+    // register garbage to GC in batches
+    std::vector<std::future<GarbageRef>> futures;
+    for (size_t i = 0; i < thread_num; ++i) {
+      std::promise<GarbageRef> p;
+      futures.emplace_back(p.get_future());
+      std::thread{&EpochBasedGCFixture::AddGarbages, this, std::move(p), kGarbageNumLarge}
+          .detach();
+    }
+    GarbageRef target_weak_ptrs;
+    for (auto &&future : futures) {
+      auto weak_ptrs = future.get();
+      target_weak_ptrs.insert(target_weak_ptrs.end(), weak_ptrs.begin(), weak_ptrs.end());
+    }
 
-      // register garbage to GC
-      auto target_weak_ptrs = TestGC(thread_num, kGarbageNumLarge);
+    // GC deletes all targets
+    gc_->StopGC();
 
-      // check target pointers remain
-      for (auto &&target_weak : target_weak_ptrs) {
-        ASSERT_FALSE(target_weak.expired());
-      }
+    // check there is no referece to target pointers
+    for (auto &&target_weak : target_weak_ptrs) {
+      ASSERT_TRUE(target_weak.expired());
     }
-
-    guarder.join();
   }
 
   void
-  VerifyReusePageIfPossible()
+  VerifyReleaseInBatch(const size_t thread_num)
   {
     // register garbage to GC
-    auto target_weak_ptrs = TestReuse(kGarbageNumLarge);
+    std::vector<std::future<GarbageRef>> futures;
+    for (size_t i = 0; i < thread_num; ++i) {
+      std::promise<GarbageRef> p;
+      futures.emplace_back(p.get_future());
+      std::thread{&EpochBasedGCFixture::AddGarbageInBatchMode, this, std::move(p),
+                  kGarbageNumLarge}
+          .detach();
+    }
+    GarbageRef target_weak_ptrs;
+    for (auto &&future : futures) {
+      auto weak_ptrs = future.get();
+      target_weak_ptrs.insert(target_weak_ptrs.end(), weak_ptrs.begin(), weak_ptrs.end());
+    }
+
+    // GC deletes all targets
     gc_->StopGC();
 
     // check there is no referece to target pointers
@@ -321,56 +463,1031 @@ class EpochBasedGCFixture : public ::testing::Test
     }
   }
 
-  /*############################################################################
-   * Internal member variables
-   *##########################################################################*/
+  void
+  VerifyAdaptiveGC()
+  {
+    constexpr size_t kLongInterval = 1E8;  // 100 s
+    constexpr size_t kWaitNum = 1000;
+    gc_.reset(nullptr);
+    gc_ = std::make_unique<EpochBasedGC_t>(gc_path_, kSize, kLayout, kLongInterval, kThreadNum,
+                                           kGarbageNumSmall);
+    gc_->StartGC();
 
-  std::unique_ptr<EpochBasedGC_t> gc_{};
+    // register garbage to GC without any epoch guard
+    std::promise<GarbageRef> p;
+    auto future = p.get_future();
+    std::thread{&EpochBasedGCFixture::AddGarbage, this, std::move(p), kGarbageNumSmall * 10}.join();
+    const auto target_weak_ptrs = future.get();
+
+    // client threads wake up GC before the interval passes
+    for (size_t i = 0; i < kWaitNum; ++i) {
+      const auto all_expired = std::all_of(target_weak_ptrs.begin(), target_weak_ptrs.end(),
+                                           [](const auto &weak) { return weak.expired(); });
+      if (all_expired) break;
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    for (auto &&target_weak : target_weak_ptrs) {
+      ASSERT_TRUE(target_weak.expired());
+    }
+  }
 
-  std::mutex mtx_{};
+  void
+  VerifyWatermarkWithSizeClasses()
+  {
+    constexpr size_t kLongInterval = 1E8;  // 100 s
+    constexpr size_t kWaitNum = 1000;
+    constexpr auto kSizes = SizeClassTarget::kPageSizes;
+    constexpr size_t kBatchSize = kSizes.size() * 4;
+    gc_.reset(nullptr);
+    gc_ = std::make_unique<EpochBasedGC_t>(gc_path_, kSize, kLayout, kLongInterval, kThreadNum,
+                                           kTmpFieldNum);
+    gc_->StartGC();
 
-  std::filesystem::path gc_path_{};
+    // add a batch of pages of every size class
+    auto *pages = gc_->GetTmpField<SizeClassTarget>(0);
+    const auto add_batch = [&]() {
+      for (size_t i = 0; i < kBatchSize; ++i) {
+        Malloc(pop_, &(pages[i]), kSizes[i % kSizes.size()]);
+      }
+      gc_->AddGarbages<SizeClassTarget>(pages, kBatchSize);
+    };
 
-  PMEMobjpool *pop_{nullptr};
-};
+    // each list does not reach the watermark, and so GC is not requested
+    add_batch();
+    std::this_thread::sleep_for(std::chrono::microseconds{kGCInterval});
+    EXPECT_EQ(gc_->GetStats<SizeClassTarget>().destructed, 0);
 
-/*##############################################################################
- * Unit test definitions
- *############################################################################*/
+    // each list crosses the watermark, and so GC is requested before the interval
+    while (gc_->GetStats<SizeClassTarget>().added < kTmpFieldNum * kSizes.size() * 2) {
+      add_batch();
+    }
+    for (size_t i = 0; i < kWaitNum; ++i) {
+      if (gc_->GetStats<SizeClassTarget>().destructed > 0) break;
+      std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    EXPECT_GT(gc_->GetStats<SizeClassTarget>().destructed, 0);
+  }
 
-TEST_F(EpochBasedGCFixture, DestructorWithSingleThreadReleaseAllGarbage)
-{  //
-  VerifyDestructor(1);
-}
+  void
+  VerifyListQuotas()
+  {
+    constexpr size_t kLongInterval = 1E8;  // 100 s
+    gc_.reset(nullptr);
+    gc_ = std::make_unique<EpochBasedGC_t>(gc_path_, kSize, kLayout, kLongInterval, kThreadNum,
+                                           kGarbageNumLarge);
+    gc_->StartGC();
 
-TEST_F(EpochBasedGCFixture, DestructorWithMultiThreadsReleaseAllGarbage)
-{  //
-  VerifyDestructor(kThreadNum);
-}
+    // a client thread adds garbage faster than the interval of GC
+    auto f = [&](std::promise<GarbageRef> p) {
+      GarbageRef target_weak_ptrs;
+      auto *garbage = gc_->GetTmpField<QuotaTarget>(0);
+      for (size_t loop = 0; loop < kGarbageNumLarge; ++loop) {
+        Malloc(pop_, garbage, sizeof(std::shared_ptr<Target>));
+        auto *shared = new (pmemobj_direct(*garbage)) std::shared_ptr<Target>{new Target{0}};
+        target_weak_ptrs.emplace_back(*shared);
+        gc_->AddGarbage<QuotaTarget>(garbage);
+      }
+      EXPECT_LE(gc_->GetStats<QuotaTarget>().live_lists, QuotaTarget::kHardListQuota);
+      p.set_value(std::move(target_weak_ptrs));
+    };
+    std::promise<GarbageRef> p;
+    auto future = p.get_future();
+    std::thread{f, std::move(p)}.join();
+    const auto target_weak_ptrs = future.get();
 
-TEST_F(EpochBasedGCFixture, StopGCWithSingleThreadReleaseAllGarbage)
-{  //
-  VerifyStopGC(1);
-}
+    // the backpressure has released most of garbage before GC
+    size_t alive = 0;
+    for (auto &&target_weak : target_weak_ptrs) {
+      alive += target_weak.expired() ? 0 : 1;
+    }
+    EXPECT_LE(alive, kBufferSize * QuotaTarget::kHardListQuota);
+  }
 
-TEST_F(EpochBasedGCFixture, StopGCWithMultiThreadsReleaseAllGarbage)
-{  //
-  VerifyStopGC(kThreadNum);
-}
+  void
+  VerifyHardQuotaWithFixedInterval()
+  {
+    // the default GC forwards the global epoch only once in each interval
+    auto f = [&](std::promise<GarbageRef> p) {
+      GarbageRef target_weak_ptrs;
+      auto *garbage = gc_->GetTmpField<QuotaTarget>(0);
+      for (size_t loop = 0; loop < kBufferSize * QuotaTarget::kHardListQuota * 4; ++loop) {
+        Malloc(pop_, garbage, sizeof(std::shared_ptr<Target>));
+        auto *shared = new (pmemobj_direct(*garbage)) std::shared_ptr<Target>{new Target{0}};
+        target_weak_ptrs.emplace_back(*shared);
+        gc_->AddGarbage<QuotaTarget>(garbage);
+        if (loop % kBufferSize == 0) {
+          EXPECT_LE(gc_->GetStats<QuotaTarget>().live_lists, QuotaTarget::kHardListQuota);
+        }
+      }
+      p.set_value(std::move(target_weak_ptrs));
+    };
+    std::promise<GarbageRef> p;
+    auto future = p.get_future();
+    const auto begin = std::chrono::steady_clock::now();
+    std::thread{f, std::move(p)}.join();
+    const auto elapsed = std::chrono::steady_clock::now() - begin;
+    const auto target_weak_ptrs = future.get();
+
+    // client threads do not wait for the interval of GC
+    EXPECT_LT(elapsed, std::chrono::microseconds{kGCInterval * QuotaTarget::kHardListQuota});
+    size_t alive = 0;
+    for (auto &&target_weak : target_weak_ptrs) {
+      alive += target_weak.expired() ? 0 : 1;
+    }
+    EXPECT_LE(alive, kBufferSize * QuotaTarget::kHardListQuota);
+  }
 
-TEST_F(EpochBasedGCFixture, CreateEpochGuardWithSingleThreadProtectGarbage)
-{
-  VerifyCreateEpochGuard(1);
-}
+  void
+  VerifySharedPagePool()
+  {
+    // a producer thread adds garbage and keeps its garbage list
+    std::promise<void> added_p;
+    std::promise<void> reused_p;
+    auto added = added_p.get_future();
+    auto reused = reused_p.get_future();
+    std::thread producer{[&]() {
+      auto *garbage = gc_->GetTmpField<SharedPoolTarget>(0);
+      for (size_t i = 0; i < kGarbageNumLarge; ++i) {
+        Malloc(pop_, garbage, sizeof(std::shared_ptr<Target>));
+        new (pmemobj_direct(*garbage)) std::shared_ptr<Target>{new Target{0}};
+        gc_->AddGarbage<SharedPoolTarget>(garbage);
+      }
+      added_p.set_value();
+      reused.wait();
+    }};
+    added.wait();
+    std::this_thread::sleep_for(std::chrono::microseconds{kGCInterval * 5});
+
+    // a consumer thread reuses pages donated by the producer
+    size_t reuse_num = 0;
+    std::thread consumer{[&]() {
+      auto *page = gc_->GetTmpField<SharedPoolTarget>(0);
+      for (size_t i = 0; i < kBufferSize * 2; ++i) {
+        gc_->GetPageIfPossible<SharedPoolTarget>(page);
+        if (OID_IS_NULL(*page)) {
+          Malloc(pop_, page, sizeof(std::shared_ptr<Target>));
+        } else {
+          ++reuse_num;
+        }
+        new (pmemobj_direct(*page)) std::shared_ptr<Target>{new Target{0}};
+        gc_->AddGarbage<SharedPoolTarget>(page);
+      }
+    }};
+    consumer.join();
+    reused_p.set_value();
+    producer.join();
 
-TEST_F(EpochBasedGCFixture, CreateEpochGuardWithMultiThreadsProtectGarbage)
-{
-  VerifyCreateEpochGuard(kThreadNum);
-}
+    EXPECT_EQ(reuse_num, kBufferSize * 2);
+  }
 
-TEST_F(EpochBasedGCFixture, ReusePageIfPossibleWithMultiThreadsReleasePageOnlyOnce)
-{  //
-  VerifyReusePageIfPossible();
+  void
+  VerifySizeClasses()
+  {
+    constexpr auto kSizes = SizeClassTarget::kPageSizes;
+    constexpr size_t kPageNum = kBufferSize * 4;
+
+    // add pages of every size class as garbage
+    auto *page = gc_->GetTmpField<SizeClassTarget>(0);
+    for (size_t i = 0; i < kPageNum; ++i) {
+      Malloc(pop_, page, kSizes[i % kSizes.size()]);
+      gc_->AddGarbage<SizeClassTarget>(page);
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds{kGCInterval * 5});
+
+    // reused pages must have the requested sizes at least
+    for (size_t i = 0; i < kPageNum; ++i) {
+      const auto size = kSizes[i % kSizes.size()];
+      gc_->GetPageIfPossible<SizeClassTarget>(page, size);
+      if (OID_IS_NULL(*page)) {
+        Malloc(pop_, page, size);
+      } else {
+        EXPECT_GE(pmemobj_alloc_usable_size(*page), size);
+      }
+      gc_->AddGarbage<SizeClassTarget>(page);
+    }
+
+    // there is no size class for too large pages
+    gc_->GetPageIfPossible<SizeClassTarget>(page, kSizes.back() + 1);
+    EXPECT_TRUE(OID_IS_NULL(*page));
+  }
+
+  void
+  VerifyStats()
+  {
+    // a thread adds garbage and exits
+    std::thread{[&]() {
+      auto *garbage = gc_->GetTmpField<BatchReleaseTarget>(0);
+      for (size_t i = 0; i < kGarbageNumLarge; ++i) {
+        Malloc(pop_, garbage, sizeof(std::shared_ptr<Target>));
+        new (pmemobj_direct(*garbage)) std::shared_ptr<Target>{new Target{0}};
+        gc_->AddGarbage<BatchReleaseTarget>(garbage);
+      }
+    }}.join();
+    auto stats = gc_->GetStats<BatchReleaseTarget>();
+    EXPECT_EQ(stats.added, kGarbageNumLarge);
+    EXPECT_GT(stats.live_lists, 0);
+    EXPECT_GE(stats.persist_num, kGarbageNumLarge);
+
+    // wait for GC to release all the garbage
+    while (stats.released < kGarbageNumLarge || stats.live_lists > 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds{kGCInterval});
+      stats = gc_->GetStats<BatchReleaseTarget>();
+    }
+    EXPECT_EQ(stats.destructed, kGarbageNumLarge);
+    EXPECT_EQ(stats.released, kGarbageNumLarge);
+    EXPECT_GE(stats.free_num, kGarbageNumLarge);
+    EXPECT_GE(stats.current_epoch, stats.min_epoch);
+
+    // reuse without any page
+    auto *page = gc_->GetTmpField<SharedPtrTarget>(0);
+    gc_->GetPageIfPossible<SharedPtrTarget>(page);
+    EXPECT_EQ(gc_->GetStats<SharedPtrTarget>().reuse_misses, 1);
+  }
+
+  void
+  VerifyStatsAfterStopGC()
+  {
+    // register garbage to GC and stop it before releasing the garbage
+    auto target_weak_ptrs = TestGC(kThreadNum, kGarbageNumLarge);
+    gc_->StopGC();
+    for (auto &&target_weak : target_weak_ptrs) {
+      EXPECT_TRUE(target_weak.expired());
+    }
+
+    // the final counters remain after the lists are destroyed
+    const auto &stats = gc_->GetStats<SharedPtrTarget>();
+    EXPECT_EQ(stats.added, target_weak_ptrs.size());
+    EXPECT_EQ(stats.destructed, target_weak_ptrs.size());
+    EXPECT_EQ(stats.released + stats.reused, target_weak_ptrs.size());
+    EXPECT_EQ(gc_->GetStats<BatchReleaseTarget>().added, 0);
+  }
+
+  void
+  VerifyRecovery(  //
+      const bool in_background)
+  {
+    constexpr size_t kGarbageNum = kBufferSize * 4;
+    const auto &pool_path = gc_path_.parent_path() / kPoolName;
+    gc_.reset(nullptr);
+    pmemobj_close(pop_);
+
+    // a child process adds garbage and exits without releasing them
+    const auto pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      auto *pop = pmemobj_open(pool_path.c_str(), kLayout);
+      EpochBasedGC_t gc{gc_path_, kSize, kLayout, kGCInterval, kThreadNum};
+      auto *garbage = gc.GetTmpField(0);
+      for (size_t i = 0; i < kGarbageNum; ++i) {
+        Malloc(pop, garbage, sizeof(Target));
+        gc.AddGarbage(garbage);
+      }
+      std::_Exit(EXIT_SUCCESS);  // emulate a machine failure
+    }
+    int status{};
+    waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+
+    // the constructor releases the remaining garbage
+    pop_ = pmemobj_open(pool_path.c_str(), kLayout);
+    gc_ = std::make_unique<EpochBasedGC_t>(gc_path_, kSize, kLayout, kGCInterval, kThreadNum,
+                                           kDefaultGCWatermark, in_background);
+    gc_->StartGC();
+
+    // the current thread can add new garbage during recovery
+    auto *garbage = gc_->GetTmpField(0);
+    Malloc(pop_, garbage, sizeof(Target));
+    gc_->AddGarbage(garbage);
+
+    const auto &info = gc_->GetRecoveryInfo();
+    EXPECT_EQ(info.list_num, 1);
+    EXPECT_EQ(info.garbage_num, kGarbageNum);
+    EXPECT_TRUE(gc_->IsRecovered());
+  }
+
+  void
+  VerifyFastShutdown()
+  {
+    constexpr size_t kGarbageNum = kBufferSize * 4;
+
+    {
+      // protect garbage from GC until shutdown
+      const auto guard = gc_->CreateEpochGuard();
+      auto *garbage = gc_->GetTmpField(0);
+      for (size_t i = 0; i < kGarbageNum; ++i) {
+        Malloc(pop_, garbage, sizeof(Target));
+        gc_->AddGarbage(garbage);
+      }
+      EXPECT_TRUE(gc_->StopGC(true));
+    }
+    gc_.reset(nullptr);
+
+    // the next construction releases the left garbage
+    gc_ = std::make_unique<EpochBasedGC_t>(gc_path_, kSize, kLayout, kGCInterval, kThreadNum);
+    gc_->StartGC();
+
+    const auto &info = gc_->GetRecoveryInfo();
+    EXPECT_EQ(info.list_num, 1);
+    EXPECT_EQ(info.garbage_num, kGarbageNum);
+  }
+
+  void
+  VerifyCompactSlots()
+  {
+    auto f = [&](std::promise<GarbageRef> p) {
+      GarbageRef target_weak_ptrs;
+      auto *garbages = gc_->GetTmpField<CompactTarget>(0);
+      for (size_t loop = 0; loop < kGarbageNumLarge; loop += kTmpFieldNum) {
+        const auto cnt = std::min(kGarbageNumLarge - loop, kTmpFieldNum);
+        for (size_t i = 0; i < cnt; ++i) {
+          gc_->GetPageIfPossible<CompactTarget>(&(garbages[i]));
+          if (OID_IS_NULL(garbages[i])) {
+            Malloc(pop_, &(garbages[i]), sizeof(std::shared_ptr<Target>));
+          }
+          auto *shared = new (pmemobj_direct(garbages[i])) std::shared_ptr<Target>{new Target{0}};
+          target_weak_ptrs.emplace_back(*shared);
+        }
+        if (loop % 2 == 0) {
+          gc_->AddGarbages<CompactTarget>(garbages, cnt);
+        } else {
+          for (size_t i = 0; i < cnt; ++i) {
+            gc_->AddGarbage<CompactTarget>(&(garbages[i]));
+          }
+        }
+      }
+      p.set_value(std::move(target_weak_ptrs));
+    };
+
+    // register garbage to lists that only have offsets
+    std::vector<std::future<GarbageRef>> futures;
+    for (size_t i = 0; i < kThreadNum; ++i) {
+      std::promise<GarbageRef> p;
+      futures.emplace_back(p.get_future());
+      std::thread{f, std::move(p)}.detach();
+    }
+    GarbageRef target_weak_ptrs;
+    for (auto &&future : futures) {
+      auto weak_ptrs = future.get();
+      target_weak_ptrs.insert(target_weak_ptrs.end(), weak_ptrs.begin(), weak_ptrs.end());
+    }
+
+    // GC deletes all targets
+    gc_->StopGC();
+    for (auto &&target_weak : target_weak_ptrs) {
+      ASSERT_TRUE(target_weak.expired());
+    }
+  }
+
+  void
+  VerifyCompactSlotsWithAnotherPool()
+  {
+    auto *garbages = gc_->GetTmpField<CompactTarget>(0);
+    for (size_t i = 0; i < 2; ++i) {
+      Malloc(pop_, &(garbages[i]), sizeof(std::shared_ptr<Target>));
+      new (pmemobj_direct(garbages[i])) std::shared_ptr<Target>{new Target{0}};
+    }
+    gc_->AddGarbage<CompactTarget>(&(garbages[0]));
+
+    // garbage of another pool is rejected and remains in the temporary field
+    garbages[0] = PMEMoid{garbages[1].pool_uuid_lo + 1, garbages[1].off};
+    EXPECT_THROW(gc_->AddGarbage<CompactTarget>(&(garbages[0])), std::runtime_error);
+    EXPECT_THROW(gc_->AddGarbages<CompactTarget>(garbages, 2), std::runtime_error);
+    EXPECT_FALSE(OID_IS_NULL(garbages[0]));
+    EXPECT_FALSE(OID_IS_NULL(garbages[1]));
+
+    // the list still accepts garbage of its own pool
+    garbages[0] = OID_NULL;
+    gc_->AddGarbage<CompactTarget>(&(garbages[1]));
+    EXPECT_TRUE(OID_IS_NULL(garbages[1]));
+    gc_->StopGC();
+    EXPECT_EQ(gc_->GetStats<CompactTarget>().added, 2);
+  }
+
+  void
+  VerifyVolatileTarget()
+  {
+    auto f = [&](std::promise<GarbageRef> p) {
+      GarbageRef target_weak_ptrs;
+      for (size_t loop = 0; loop < kGarbageNumLarge; ++loop) {
+        auto *page = gc_->GetPageIfPossible<VolatileTarget>();
+        if (page == nullptr) {
+          page = ::operator new(sizeof(std::shared_ptr<Target>));
+        }
+        auto *shared = new (page) std::shared_ptr<Target>{new Target{0}};
+        target_weak_ptrs.emplace_back(*shared);
+        gc_->AddGarbage<VolatileTarget>(page);
+      }
+      p.set_value(std::move(target_weak_ptrs));
+    };
+
+    // register garbage in DRAM
+    std::vector<std::future<GarbageRef>> futures;
+    for (size_t i = 0; i < kThreadNum; ++i) {
+      std::promise<GarbageRef> p;
+      futures.emplace_back(p.get_future());
+      std::thread{f, std::move(p)}.detach();
+    }
+    GarbageRef target_weak_ptrs;
+    for (auto &&future : futures) {
+      auto weak_ptrs = future.get();
+      target_weak_ptrs.insert(target_weak_ptrs.end(), weak_ptrs.begin(), weak_ptrs.end());
+    }
+
+    // GC deletes all targets
+    gc_->StopGC();
+    for (auto &&target_weak : target_weak_ptrs) {
+      ASSERT_TRUE(target_weak.expired());
+    }
+  }
+
+  void
+  VerifyMultiplePools()
+  {
+    // use a pool for each NUMA node
+    auto pool_path_0 = gc_path_;
+    auto pool_path_1 = gc_path_;
+    pool_path_0 += "_node0";
+    pool_path_1 += "_node1";
+    const std::vector<std::string> paths{pool_path_0, pool_path_1};
+    gc_.reset(nullptr);
+    gc_ = std::make_unique<EpochBasedGC_t>(paths, kSize, kLayout, kGCInterval, kThreadNum);
+    gc_->StartGC();
+
+    // register garbage to GC
+    auto target_weak_ptrs = TestGC(kThreadNum, kGarbageNumLarge);
+
+    // GC deletes all targets in each pool
+    gc_->StopGC();
+    for (auto &&target_weak : target_weak_ptrs) {
+      ASSERT_TRUE(target_weak.expired());
+    }
+  }
+
+  void
+  VerifyExistingPool()
+  {
+    // use a pool of application data for GC
+    auto pool_path = gc_path_;
+    pool_path += "_shared";
+    auto *pop = std::filesystem::exists(pool_path)
+                    ? pmemobj_open(pool_path.c_str(), kLayout)
+                    : pmemobj_create(pool_path.c_str(), kLayout, kSize, kModeRW);
+    ASSERT_NE(pop, nullptr);
+    auto *gc_root = reinterpret_cast<PMEMoid *>(pmemobj_direct(pmemobj_root(pop, kWordSize)));
+    gc_.reset(nullptr);
+    std::swap(pop_, pop);
+    gc_ = std::make_unique<EpochBasedGC_t>(pop_, gc_root, kGCInterval, kThreadNum);
+    gc_->StartGC();
+
+    // register garbage to GC
+    auto target_weak_ptrs = TestGC(kThreadNum, kGarbageNumLarge);
+
+    // GC deletes all targets and keeps the pool opened
+    gc_->StopGC();
+    for (auto &&target_weak : target_weak_ptrs) {
+      EXPECT_TRUE(target_weak.expired());
+    }
+    gc_.reset(nullptr);
+    EXPECT_FALSE(OID_IS_NULL(*gc_root));
+    std::swap(pop_, pop);
+    pmemobj_close(pop);
+  }
+
+  void
+  VerifyExistingPoolWithOldLayout()
+  {
+    // use a pool of application data for GC
+    auto pool_path = gc_path_;
+    pool_path += "_old";
+    auto *pop = std::filesystem::exists(pool_path)
+                    ? pmemobj_open(pool_path.c_str(), kLayout)
+                    : pmemobj_create(pool_path.c_str(), kLayout, kSize, kModeRW);
+    ASSERT_NE(pop, nullptr);
+    auto *gc_root = reinterpret_cast<PMEMoid *>(pmemobj_direct(pmemobj_root(pop, kWordSize)));
+
+    // emulate a root region with thread-local fields written by an older version
+    Zalloc(pop, gc_root, kPMEMLineSize * 16);
+    auto *roots = reinterpret_cast<PMEMoid *>(pmemobj_direct(*gc_root));
+    roots[0] = *gc_root;
+    EXPECT_THROW(EpochBasedGC_t(pop, gc_root, kGCInterval, kThreadNum), std::runtime_error);
+
+    roots[0] = OID_NULL;
+    pmemobj_free(gc_root);
+    pmemobj_close(pop);
+  }
+
+  void
+  VerifyTLSChunks()
+  {
+    // use a pool of application data to inspect the root of GC
+    auto pool_path = gc_path_;
+    pool_path += "_chunks";
+    auto *pop = std::filesystem::exists(pool_path)
+                    ? pmemobj_open(pool_path.c_str(), kLayout)
+                    : pmemobj_create(pool_path.c_str(), kLayout, kSize, kModeRW);
+    ASSERT_NE(pop, nullptr);
+    auto *gc_root = reinterpret_cast<PMEMoid *>(pmemobj_direct(pmemobj_root(pop, kWordSize)));
+    gc_.reset(nullptr);
+    std::swap(pop_, pop);
+    gc_ = std::make_unique<EpochBasedGC_t>(pop_, gc_root, kGCInterval, kThreadNum);
+    gc_->StartGC();
+
+    // a lambda function to count allocated chunks of thread-local fields
+    auto count_chunks = [&](const size_t pos) {
+      auto *roots = reinterpret_cast<PMEMoid *>(pmemobj_direct(*gc_root));
+      const auto &dir_oid = roots[pos];
+      const auto *dir = reinterpret_cast<PMEMoid *>(pmemobj_direct(dir_oid));
+      const auto chunk_num = pmemobj_alloc_usable_size(dir_oid) / sizeof(PMEMoid);
+      size_t cnt = 0;
+      for (size_t i = 0; i < chunk_num; ++i) {
+        cnt += OID_IS_NULL(dir[i]) ? 0 : 1;
+      }
+      return cnt;
+    };
+
+    // unused targets do not have any chunk
+    constexpr size_t kDefaultPos = 0;
+    constexpr size_t kSharedPtrPos = 1;
+    EXPECT_EQ(count_chunks(kDefaultPos), 0);
+    EXPECT_EQ(count_chunks(kSharedPtrPos), 0);
+    EXPECT_TRUE(gc_->GetUnreleasedFields<DefaultTarget>().empty());
+
+    // register garbage to GC
+    auto target_weak_ptrs = TestGC(kThreadNum, kGarbageNumSmall);
+    gc_->StopGC();
+    for (auto &&target_weak : target_weak_ptrs) {
+      EXPECT_TRUE(target_weak.expired());
+    }
+
+    // only the chunks of used thread IDs are allocated
+    const auto chunk_num = count_chunks(kSharedPtrPos);
+    EXPECT_GT(chunk_num, 0);
+    EXPECT_LE(chunk_num, kThreadNum);
+    EXPECT_EQ(count_chunks(kDefaultPos), 0);
+
+    gc_.reset(nullptr);
+    std::swap(pop_, pop);
+    pmemobj_close(pop);
+  }
+
+  void
+  VerifyCleanersMoreThanWords()
+  {
+    constexpr size_t kWordNum = (::dbgroup::thread::kMaxThreadNum + 63) / 64;
+    constexpr size_t kCleanerNum = kWordNum + 2;
+    constexpr size_t kGarbageNum = 8;
+    gc_.reset(nullptr);
+    gc_ = std::make_unique<EpochBasedGC_t>(gc_path_, kSize, kLayout, kGCInterval, kCleanerNum);
+    gc_->StartGC();
+
+    // client threads keep their IDs until all the garbage is destructed
+    std::promise<void> p;
+    auto f = p.get_future().share();
+    std::vector<std::thread> threads{};
+    for (size_t i = 0; i < kCleanerNum; ++i) {
+      threads.emplace_back([&, f]() {
+        auto *garbage = gc_->GetTmpField<RecordedTarget>(0);
+        for (size_t j = 0; j < kGarbageNum; ++j) {
+          Malloc(pop_, garbage, sizeof(CleanerRecorder));
+          new (pmemobj_direct(*garbage)) CleanerRecorder{};
+          gc_->AddGarbage<RecordedTarget>(garbage);
+        }
+        f.wait();
+      });
+    }
+    while (true) {
+      std::this_thread::sleep_for(std::chrono::microseconds{kGCInterval});
+      const std::lock_guard guard{cleaner_mtx_};
+      if (cleaner_ids_.size() >= kCleanerNum * kGarbageNum) break;
+    }
+    p.set_value();
+    for (auto &&t : threads) {
+      t.join();
+    }
+
+    // cleaners more than bitmap words share the lists of the client threads
+    std::sort(cleaner_ids_.begin(), cleaner_ids_.end());
+    const auto end = std::unique(cleaner_ids_.begin(), cleaner_ids_.end());
+    EXPECT_GT(static_cast<size_t>(std::distance(cleaner_ids_.begin(), end)), kWordNum);
+    cleaner_ids_.clear();
+  }
+
+  void
+  VerifyCreateEpochGuard(const size_t thread_num)
+  {
+    // a lambda function to keep an epoch guard
+    auto create_guard = [&](std::promise<Target> p) {
+      const auto guard = gc_->CreateEpochGuard();
+      p.set_value(0);  // set promise to notice
+      const auto lock = std::unique_lock<std::mutex>{mtx_};
+    };
+
+    // create an epoch guard on anther thread
+    std::thread guarder;
+
+    {
+      // create a lock to keep an epoch guard
+      const auto thread_lock = std::unique_lock<std::mutex>{mtx_};
+
+      // create an epoch guard
+      std::promise<Target> p;
+      auto f = p.get_future();
+      guarder = std::thread{create_guard, std::move(p)};
+      f.get();
+
+      // register garbage to GC
+      auto target_weak_ptrs = TestGC(thread_num, kGarbageNumLarge);
+
+      // check target pointers remain
+      for (auto &&target_weak : target_weak_ptrs) {
+        ASSERT_FALSE(target_weak.expired());
+      }
+    }
+
+    guarder.join();
+  }
+
+  template <class GCTarget>
+  void
+  VerifyAllocate(const size_t thread_num)
+  {
+    auto f = [&](std::promise<GarbageRef> p) {
+      GarbageRef target_weak_ptrs;
+      for (size_t loop = 0; loop < kGarbageNumLarge; ++loop) {
+        auto *garbage = gc_->Allocate<GCTarget>(pop_, 0, sizeof(std::shared_ptr<Target>));
+        ASSERT_FALSE(OID_IS_NULL(*garbage));
+        auto *shared = new (pmemobj_direct(*garbage)) std::shared_ptr<Target>{new Target{0}};
+        target_weak_ptrs.emplace_back(*shared);
+        gc_->AddGarbage<GCTarget>(garbage);
+      }
+      p.set_value(std::move(target_weak_ptrs));
+    };
+
+    std::vector<std::future<GarbageRef>> futures;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_num; ++i) {
+      std::promise<GarbageRef> p;
+      futures.emplace_back(p.get_future());
+      threads.emplace_back(f, std::move(p));
+    }
+    for (auto &&t : threads) {
+      t.join();
+    }
+    gc_->StopGC();
+
+    // reserved but unused pages are cancelled in the destructor
+    for (auto &&future : futures) {
+      for (auto &&target_weak : future.get()) {
+        ASSERT_TRUE(target_weak.expired());
+      }
+    }
+  }
+
+  void
+  VerifyTargetIntervals()
+  {
+    // wait for the first pass that clears every target
+    std::this_thread::sleep_for(std::chrono::microseconds{kGCInterval * 2});
+
+    GarbageRef lazy_weak_ptrs;
+    GarbageRef urgent_weak_ptrs;
+    std::thread{[&]() {
+      AddGarbageWithoutReuse<LazyTarget>(&lazy_weak_ptrs);
+      AddGarbageWithoutReuse<UrgentTarget>(&urgent_weak_ptrs);
+    }}.join();
+    std::this_thread::sleep_for(std::chrono::microseconds{kGCInterval * 5});
+
+    // only the target with the default interval has been cleared
+    for (auto &&target_weak : urgent_weak_ptrs) {
+      EXPECT_TRUE(target_weak.expired());
+    }
+    for (auto &&target_weak : lazy_weak_ptrs) {
+      EXPECT_FALSE(target_weak.expired());
+    }
+
+    gc_->StopGC();
+    for (auto &&target_weak : lazy_weak_ptrs) {
+      EXPECT_TRUE(target_weak.expired());
+    }
+  }
+
+  void
+  VerifyReentrantGuard()
+  {
+    GarbageRef target_weak_ptrs;
+    const auto handle = gc_->GetThreadHandle<SharedPtrTarget>();
+    {
+      const auto outer = gc_->CreateReentrantGuard(handle);
+      {
+        // an inner guard does not enter the epoch again
+        const auto inner = gc_->CreateReentrantGuard();
+        auto *garbage = gc_->GetTmpField(handle, 0);
+        for (size_t loop = 0; loop < kGarbageNumLarge; ++loop) {
+          gc_->GetPageIfPossible(handle, garbage);
+          if (OID_IS_NULL(*garbage)) {
+            Malloc(pop_, garbage, sizeof(std::shared_ptr<Target>));
+          }
+          auto *shared = new (pmemobj_direct(*garbage)) std::shared_ptr<Target>{new Target{0}};
+          target_weak_ptrs.emplace_back(*shared);
+          gc_->AddGarbage(handle, garbage);
+        }
+      }
+
+      // the outer guard still protects garbage
+      std::this_thread::sleep_for(std::chrono::microseconds{kGCInterval * 2});
+      for (auto &&target_weak : target_weak_ptrs) {
+        ASSERT_FALSE(target_weak.expired());
+      }
+    }
+
+    gc_->StopGC();
+    for (auto &&target_weak : target_weak_ptrs) {
+      ASSERT_TRUE(target_weak.expired());
+    }
+  }
+
+  void
+  VerifyIntervalGuard()
+  {
+    const auto add_garbage = [&](GarbageRef *target_weak_ptrs, const bool with_birth) {
+      auto *garbage = gc_->GetTmpField<IntervalTarget>(0);
+      for (size_t loop = 0; loop < kGarbageNumSmall; ++loop) {
+        const auto birth = gc_->GetCurrentEpoch();
+        Malloc(pop_, garbage, sizeof(std::shared_ptr<Target>));
+        auto *shared = new (pmemobj_direct(*garbage)) std::shared_ptr<Target>{new Target{0}};
+        target_weak_ptrs->emplace_back(*shared);
+        if (with_birth) {
+          gc_->AddGarbage<IntervalTarget>(garbage, birth);
+        } else {
+          gc_->AddGarbage<IntervalTarget>(garbage);
+        }
+      }
+    };
+
+    GarbageRef old_weak_ptrs;
+    GarbageRef young_weak_ptrs;
+    {
+      // a stalled reader that has read a shared pointer only once
+      const auto guard = gc_->CreateIntervalGuard();
+      EXPECT_EQ(guard.Read([]() { return 0; }), 0);
+      std::thread{add_garbage, &old_weak_ptrs, false}.join();
+
+      // garbage allocated after the last read is not protected by the reader
+      std::this_thread::sleep_for(std::chrono::microseconds{kGCInterval * 2});
+      std::thread{add_garbage, &young_weak_ptrs, true}.join();
+      std::this_thread::sleep_for(std::chrono::microseconds{kGCInterval * 5});
+      for (auto &&target_weak : young_weak_ptrs) {
+        EXPECT_TRUE(target_weak.expired());
+      }
+      for (auto &&target_weak : old_weak_ptrs) {
+        EXPECT_FALSE(target_weak.expired());
+      }
+    }
+
+    gc_->StopGC();
+    for (auto &&target_weak : old_weak_ptrs) {
+      EXPECT_TRUE(target_weak.expired());
+    }
+  }
+
+  void
+  VerifyNestedIntervalGuards()
+  {
+    const auto add_garbage = [&](GarbageRef *target_weak_ptrs) {
+      auto *garbage = gc_->GetTmpField<IntervalTarget>(0);
+      for (size_t loop = 0; loop < kGarbageNumSmall; ++loop) {
+        Malloc(pop_, garbage, sizeof(std::shared_ptr<Target>));
+        auto *shared = new (pmemobj_direct(*garbage)) std::shared_ptr<Target>{new Target{0}};
+        target_weak_ptrs->emplace_back(*shared);
+        gc_->AddGarbage<IntervalTarget>(garbage);
+      }
+    };
+
+    GarbageRef target_weak_ptrs;
+    {
+      const auto guard = gc_->CreateIntervalGuard();
+      EXPECT_EQ(guard.Read([]() { return 0; }), 0);
+      {
+        const auto inner = gc_->CreateIntervalGuard();
+        EXPECT_EQ(inner.Read([]() { return 0; }), 0);
+      }
+
+      // the outer guard still protects garbage after the inner one is released
+      std::thread{add_garbage, &target_weak_ptrs}.join();
+      std::this_thread::sleep_for(std::chrono::microseconds{kGCInterval * 5});
+      for (auto &&target_weak : target_weak_ptrs) {
+        EXPECT_FALSE(target_weak.expired());
+      }
+    }
+
+    gc_->StopGC();
+    for (auto &&target_weak : target_weak_ptrs) {
+      EXPECT_TRUE(target_weak.expired());
+    }
+  }
+
+  void
+  VerifyReusePageIfPossible()
+  {
+    // register garbage to GC
+    auto target_weak_ptrs = TestReuse(kGarbageNumLarge);
+    gc_->StopGC();
+
+    // check there is no referece to target pointers
+    for (auto &&target_weak : target_weak_ptrs) {
+      ASSERT_TRUE(target_weak.expired());
+    }
+  }
+
+  /*############################################################################
+   * Internal member variables
+   *##########################################################################*/
+
+  std::unique_ptr<EpochBasedGC_t> gc_{};
+
+  std::mutex mtx_{};
+
+  std::filesystem::path gc_path_{};
+
+  PMEMobjpool *pop_{nullptr};
+
+  inline static std::mutex cleaner_mtx_{};
+
+  inline static std::vector<std::thread::id> cleaner_ids_{};
+};
+
+/*##############################################################################
+ * Unit test definitions
+ *############################################################################*/
+
+TEST_F(EpochBasedGCFixture, DestructorWithSingleThreadReleaseAllGarbage)
+{  //
+  VerifyDestructor(1);
+}
+
+TEST_F(EpochBasedGCFixture, DestructorWithMultiThreadsReleaseAllGarbage)
+{  //
+  VerifyDestructor(kThreadNum);
+}
+
+TEST_F(EpochBasedGCFixture, StopGCWithSingleThreadReleaseAllGarbage)
+{  //
+  VerifyStopGC(1);
+}
+
+TEST_F(EpochBasedGCFixture, StopGCWithMultiThreadsReleaseAllGarbage)
+{  //
+  VerifyStopGC(kThreadNum);
+}
+
+TEST_F(EpochBasedGCFixture, AddGarbagesWithMultiThreadsReleaseAllGarbage)
+{  //
+  VerifyAddGarbages(kThreadNum);
+}
+
+TEST_F(EpochBasedGCFixture, ReleaseInBatchWithMultiThreadsReleaseAllGarbage)
+{  //
+  VerifyReleaseInBatch(kThreadNum);
+}
+
+TEST_F(EpochBasedGCFixture, AdaptiveGCWithWatermarkReleaseGarbageBeforeInterval)
+{  //
+  VerifyAdaptiveGC();
+}
+
+TEST_F(EpochBasedGCFixture, AddGarbagesWithSizeClassesRequestGCByWatermarkOfEachList)
+{  //
+  VerifyWatermarkWithSizeClasses();
+}
+
+TEST_F(EpochBasedGCFixture, AddGarbageOverQuotasReclaimOwnGarbage)
+{  //
+  VerifyListQuotas();
+}
+
+TEST_F(EpochBasedGCFixture, AddGarbageWithFixedIntervalKeepHardListQuota)
+{  //
+  VerifyHardQuotaWithFixedInterval();
+}
+
+TEST_F(EpochBasedGCFixture, GetPageIfPossibleWithSharedPoolReusePagesOfOtherThreads)
+{  //
+  VerifySharedPagePool();
+}
+
+TEST_F(EpochBasedGCFixture, GetPageIfPossibleWithSizeClassesReturnLargeEnoughPages)
+{  //
+  VerifySizeClasses();
+}
+
+TEST_F(EpochBasedGCFixture, CompactSlotsWithMultiThreadsReleaseAllGarbage)
+{  //
+  VerifyCompactSlots();
+}
+
+TEST_F(EpochBasedGCFixture, CompactSlotsWithAnotherPoolThrowRuntimeError)
+{  //
+  VerifyCompactSlotsWithAnotherPool();
+}
+
+TEST_F(EpochBasedGCFixture, VolatileTargetWithMultiThreadsReleaseAllGarbage)
+{  //
+  VerifyVolatileTarget();
+}
+
+TEST_F(EpochBasedGCFixture, ConstructorWithMultiplePoolsReleaseAllGarbage)
+{  //
+  VerifyMultiplePools();
+}
+
+TEST_F(EpochBasedGCFixture, ConstructorWithExistingPoolReleaseAllGarbage)
+{  //
+  VerifyExistingPool();
+}
+
+TEST_F(EpochBasedGCFixture, ConstructorWithOldLayoutRootThrowRuntimeError)
+{  //
+  VerifyExistingPoolWithOldLayout();
+}
+
+TEST_F(EpochBasedGCFixture, AddGarbageWithFewThreadsAllocateOnlyUsedTLSChunks)
+{  //
+  VerifyTLSChunks();
+}
+
+TEST_F(EpochBasedGCFixture, ClearGarbageWithCleanersMoreThanWordsShareLists)
+{  //
+  VerifyCleanersMoreThanWords();
+}
+
+TEST_F(EpochBasedGCFixture, CreateEpochGuardWithSingleThreadProtectGarbage)
+{
+  VerifyCreateEpochGuard(1);
+}
+
+TEST_F(EpochBasedGCFixture, CreateEpochGuardWithMultiThreadsProtectGarbage)
+{
+  VerifyCreateEpochGuard(kThreadNum);
+}
+
+TEST_F(EpochBasedGCFixture, AllocateWithReusePagesReleaseAllGarbage)
+{  //
+  VerifyAllocate<SharedPtrTarget>(kThreadNum);
+}
+
+TEST_F(EpochBasedGCFixture, AllocateWithoutReusePagesReleaseAllGarbage)
+{  //
+  VerifyAllocate<BatchReleaseTarget>(kThreadNum);
+}
+
+TEST_F(EpochBasedGCFixture, TargetIntervalsDelayGarbageOfLazyTargets)
+{  //
+  VerifyTargetIntervals();
+}
+
+TEST_F(EpochBasedGCFixture, CreateReentrantGuardWithNestedScopesProtectGarbage)
+{  //
+  VerifyReentrantGuard();
+}
+
+TEST_F(EpochBasedGCFixture, CreateIntervalGuardWithStalledReaderReleaseYoungGarbage)
+{  //
+  VerifyIntervalGuard();
+}
+
+TEST_F(EpochBasedGCFixture, CreateIntervalGuardInNestedScopesKeepOuterInterval)
+{  //
+  VerifyNestedIntervalGuards();
+}
+
+TEST_F(EpochBasedGCFixture, ReusePageIfPossibleWithMultiThreadsReleasePageOnlyOnce)
+{  //
+  VerifyReusePageIfPossible();
+}
+
+TEST_F(EpochBasedGCFixture, GetStatsAfterGCCountAllGarbage)
+{  //
+  VerifyStats();
+}
+
+TEST_F(EpochBasedGCFixture, GetStatsAfterStopGCReturnFinalCounters)
+{  //
+  VerifyStatsAfterStopGC();
+}
+
+TEST_F(EpochBasedGCFixture, StopGCWithFastShutdownLeaveGarbageForRecovery)
+{  //
+  VerifyFastShutdown();
+}
+
+TEST_F(EpochBasedGCFixture, ConstructorAfterFailureReleaseRemainingGarbage)
+{  //
+  VerifyRecovery(false);
+}
+
+TEST_F(EpochBasedGCFixture, ConstructorAfterFailureReleaseRemainingGarbageInBackground)
+{  //
+  VerifyRecovery(true);
 }
 
 TEST_F(EpochBasedGCFixture, RunGCMultipleTimesWithSamePool)
@@ -18,6 +18,7 @@
 #include "pmem/memory/component/list_header.hpp"
 
 // C++ standard libraries
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -74,11 +75,27 @@ class LIstHeaderFixture : public ::testing::Test
     static constexpr bool kOnPMEM = true;
   };
 
+  struct BatchReleaseTarget : public DefaultTarget {
+    using T = std::shared_ptr<Target>;
+    static constexpr bool kReleaseInBatch = true;
+  };
+
+  struct PrefetchReuseTarget : public SharedPtrTarget {
+    static constexpr size_t kPrefetchDistance = kBufferSize + kBufferSize / 2;
+  };
+
+  struct PrefetchReleaseTarget : public BatchReleaseTarget {
+    static constexpr size_t kPrefetchDistance = kBufferSize + kBufferSize / 2;
+  };
+
   /*############################################################################
    * Type aliases
    *##########################################################################*/
 
   using GarbageList_t = ListHeader<SharedPtrTarget>;
+  using BatchList_t = ListHeader<BatchReleaseTarget>;
+  using PrefetchReuseList_t = ListHeader<PrefetchReuseTarget>;
+  using PrefetchReleaseList_t = ListHeader<PrefetchReleaseTarget>;
 
   /*############################################################################
    * Test setup/teardown
@@ -96,10 +113,18 @@ class LIstHeaderFixture : public ::testing::Test
     } else {
       pop_ = pmemobj_create(pool_path.c_str(), kTestName, kSize, kModeRW);
     }
-    auto *root_addr = pmemobj_direct(pmemobj_root(pop_, sizeof(TLSFields)));
+    constexpr size_t kRootSize = sizeof(TLSFields) * 4 + sizeof(SpareLists);
+    auto *root_addr = pmemobj_direct(pmemobj_root(pop_, kRootSize));
     auto *tls = reinterpret_cast<TLSFields *>(root_addr);
+    spares_ = reinterpret_cast<SpareLists *>(tls + 4);
     list_ = std::make_unique<GarbageList_t>();
     list_->SetPMEMInfo(pop_, tls);
+    batch_list_ = std::make_unique<BatchList_t>();
+    batch_list_->SetPMEMInfo(pop_, tls + 1);
+    prefetch_reuse_list_ = std::make_unique<PrefetchReuseList_t>();
+    prefetch_reuse_list_->SetPMEMInfo(pop_, tls + 2);
+    prefetch_release_list_ = std::make_unique<PrefetchReleaseList_t>();
+    prefetch_release_list_->SetPMEMInfo(pop_, tls + 3);
 
     // initialize members
     current_epoch_ = 1;
@@ -110,6 +135,11 @@ class LIstHeaderFixture : public ::testing::Test
   TearDown() override
   {
     list_.reset(nullptr);
+    batch_list_.reset(nullptr);
+    prefetch_reuse_list_.reset(nullptr);
+    prefetch_release_list_.reset(nullptr);
+    GarbageListInPMEM::ReleaseEmptyLists(&(spares_->ready));
+    GarbageListInPMEM::ReleaseEmptyLists(&(spares_->returned));
 
     auto *root_addr = pmemobj_direct(pmemobj_root(pop_, sizeof(PMEMoid)));
     auto *tls_oid = reinterpret_cast<PMEMoid *>(root_addr);
@@ -141,6 +171,92 @@ class LIstHeaderFixture : public ::testing::Test
     }
   }
 
+  void
+  AddGarbages(  //
+      const size_t n)
+  {
+    auto *garbages = list_->GetTmpField(0);
+    for (size_t i = 0; i < n; i += kTmpFieldNum) {
+      const auto cnt = std::min(n - i, kTmpFieldNum);
+      for (size_t j = 0; j < cnt; ++j) {
+        Malloc(pop_, &(garbages[j]), sizeof(std::shared_ptr<Target>));
+        auto *target = new Target{0};
+        auto *shared = new (pmemobj_direct(garbages[j])) std::shared_ptr<Target>{target};
+        references_.emplace_back(*shared);
+      }
+      list_->AddGarbages(current_epoch_.load(), garbages, cnt);
+      for (size_t j = 0; j < cnt; ++j) {
+        EXPECT_TRUE(OID_IS_NULL(garbages[j]));
+      }
+    }
+  }
+
+  void
+  AddGarbageToBatchList(  //
+      const size_t n)
+  {
+    auto *garbage = batch_list_->GetTmpField(0);
+    for (size_t i = 0; i < n; ++i) {
+      Malloc(pop_, garbage, sizeof(std::shared_ptr<Target>));
+      auto *target = new Target{0};
+      auto *shared = new (pmemobj_direct(*garbage)) std::shared_ptr<Target>{target};
+      references_.emplace_back(*shared);
+      batch_list_->AddGarbage(current_epoch_.load(), garbage);
+    }
+  }
+
+  template <class List>
+  void
+  VerifyClearGarbageWithPrefetch(  //
+      List *list)
+  {
+    // add garbage with increasing epochs so that the last list is partially filled
+    const size_t begin_epoch = current_epoch_.load();
+    const size_t garbage_num = kBufferSize * 2 + kBufferSize / 3;
+    auto *garbage = list->GetTmpField(0);
+    for (size_t i = 0; i < garbage_num; ++i) {
+      Malloc(pop_, garbage, sizeof(std::shared_ptr<Target>));
+      auto *target = new Target{0};
+      auto *shared = new (pmemobj_direct(*garbage)) std::shared_ptr<Target>{target};
+      references_.emplace_back(*shared);
+      list->AddGarbage(begin_epoch + i, garbage);
+    }
+
+    // each range is shorter than the prefetch distance and may cross lists
+    for (const auto released : {size_t{1}, kBufferSize / 2, kBufferSize + 7, kBufferSize * 2 + 1}) {
+      list->ClearGarbage(begin_epoch + released);
+      CheckGarbage(released);
+    }
+    list->ClearGarbage(kMaxLong);
+
+    CheckGarbage(garbage_num);
+  }
+
+  static auto
+  CountLists(              //
+      const PMEMoid &head)  //
+      -> size_t
+  {
+    size_t cnt = 0;
+    for (auto oid = head; !OID_IS_NULL(oid); ++cnt) {
+      oid = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(oid))->next;
+    }
+    return cnt;
+  }
+
+  static auto
+  HaveCompanions(           //
+      const PMEMoid &head)  //
+      -> bool
+  {
+    for (auto oid = head; !OID_IS_NULL(oid);) {
+      auto *list = reinterpret_cast<GarbageListInPMEM *>(pmemobj_direct(oid));
+      if (list->dram == nullptr) return false;
+      oid = list->next;
+    }
+    return true;
+  }
+
   void
   CheckGarbage(  //
       const size_t n)
@@ -164,6 +280,14 @@ class LIstHeaderFixture : public ::testing::Test
   PMEMobjpool *pop_{nullptr};
 
   std::unique_ptr<GarbageList_t> list_{};
+
+  std::unique_ptr<BatchList_t> batch_list_{};
+
+  std::unique_ptr<PrefetchReuseList_t> prefetch_reuse_list_{};
+
+  std::unique_ptr<PrefetchReleaseList_t> prefetch_release_list_{};
+
+  SpareLists *spares_{nullptr};
 };
 
 /*##############################################################################
@@ -190,6 +314,122 @@ TEST_F(LIstHeaderFixture, ClearGarbageWithProtectedEpochKeepProtectedGarbage)
   CheckGarbage(kLargeNum);
 }
 
+TEST_F(LIstHeaderFixture, AddGarbagesWithoutProtectedEpochReleaseAllGarbage)
+{
+  AddGarbages(kLargeNum);
+  list_->ClearGarbage(kMaxLong);
+
+  CheckGarbage(kLargeNum);
+}
+
+TEST_F(LIstHeaderFixture, AddGarbagesWithProtectedEpochKeepProtectedGarbage)
+{
+  const size_t protected_epoch = current_epoch_.load() + 1;
+
+  AddGarbages(kLargeNum);
+  current_epoch_ = protected_epoch;
+  AddGarbages(kLargeNum);
+  list_->ClearGarbage(protected_epoch);
+
+  CheckGarbage(kLargeNum);
+}
+
+TEST_F(LIstHeaderFixture, ClearGarbageInBatchWithoutProtectedEpochReleaseAllGarbage)
+{
+  AddGarbageToBatchList(kLargeNum);
+  batch_list_->ClearGarbage(kMaxLong);
+
+  CheckGarbage(kLargeNum);
+}
+
+TEST_F(LIstHeaderFixture, ClearGarbageInBatchWithProtectedEpochKeepProtectedGarbage)
+{
+  const size_t protected_epoch = current_epoch_.load() + 1;
+
+  AddGarbageToBatchList(kLargeNum);
+  current_epoch_ = protected_epoch;
+  AddGarbageToBatchList(kLargeNum);
+  batch_list_->ClearGarbage(protected_epoch);
+
+  CheckGarbage(kLargeNum);
+}
+
+TEST_F(LIstHeaderFixture, ClearGarbageWithIncreasingEpochsKeepProtectedSuffix)
+{
+  const size_t begin_epoch = current_epoch_.load();
+  const size_t released_num = kBufferSize * 2 + kBufferSize / 2 + 1;
+
+  for (size_t i = 0; i < kLargeNum; ++i) {
+    current_epoch_ = begin_epoch + i;
+    AddGarbage(1);
+  }
+  list_->ClearGarbage(begin_epoch + released_num);
+
+  CheckGarbage(released_num);
+}
+
+TEST_F(LIstHeaderFixture, ClearGarbageInBatchWithIncreasingEpochsKeepProtectedSuffix)
+{
+  const size_t begin_epoch = current_epoch_.load();
+  const size_t released_num = kBufferSize + kBufferSize / 2 + 1;
+
+  for (size_t i = 0; i < kLargeNum; ++i) {
+    current_epoch_ = begin_epoch + i;
+    AddGarbageToBatchList(1);
+  }
+  batch_list_->ClearGarbage(begin_epoch + released_num);
+
+  CheckGarbage(released_num);
+}
+
+TEST_F(LIstHeaderFixture, ClearGarbageInBatchWithMaxNumReleaseOnlyGivenNumber)
+{
+  const size_t max_num = kBufferSize / 2 + 1;
+
+  AddGarbageToBatchList(kLargeNum);
+  for (size_t released = max_num; released < kLargeNum; released += max_num) {
+    EXPECT_TRUE(batch_list_->ClearGarbage(kMaxLong, nullptr, max_num));
+    CheckGarbage(released);
+  }
+  batch_list_->ClearGarbage(kMaxLong);
+
+  CheckGarbage(kLargeNum);
+}
+
+TEST_F(LIstHeaderFixture, ClearGarbageWithLongPrefetchDistanceReleaseOnlyUnprotectedGarbage)
+{
+  VerifyClearGarbageWithPrefetch(prefetch_reuse_list_.get());
+}
+
+TEST_F(LIstHeaderFixture, ClearGarbageInBatchWithLongPrefetchDistanceReleaseOnlyUnprotectedGarbage)
+{
+  VerifyClearGarbageWithPrefetch(prefetch_release_list_.get());
+}
+
+TEST_F(LIstHeaderFixture, SetSpareListsRecycleDrainedLists)
+{
+  constexpr size_t kSpareNum = 2;
+  batch_list_->SetSpareLists(spares_, kSpareNum);
+  EXPECT_EQ(CountLists(spares_->ready), 0);
+
+  // spare lists are allocated when a client thread first uses the list
+  batch_list_->AssignCurrentThreadIfNeeded();
+  EXPECT_EQ(CountLists(spares_->ready), kSpareNum - 1);
+
+  // client threads use spare lists and cleaner threads return drained ones
+  AddGarbageToBatchList(kLargeNum);
+  EXPECT_EQ(CountLists(spares_->ready), 0);
+  batch_list_->ClearGarbage(kMaxLong);
+  EXPECT_EQ(CountLists(spares_->returned), kSpareNum);
+  EXPECT_TRUE(HaveCompanions(spares_->returned));
+  CheckGarbage(kLargeNum);
+
+  // returned lists are moved to ready ones at once
+  AddGarbageToBatchList(1);
+  EXPECT_EQ(CountLists(spares_->ready), kSpareNum);
+  EXPECT_EQ(CountLists(spares_->returned), 0);
+}
+
 TEST_F(LIstHeaderFixture, GetPageIfPossibleWithoutPagesReturnNullptr)
 {
   auto *oid = list_->GetTmpField(0);
@@ -213,6 +453,37 @@ TEST_F(LIstHeaderFixture, GetPageIfPossibleWithPagesReturnReusablePage)
   EXPECT_TRUE(OID_IS_NULL(*oid));
 }
 
+TEST_F(LIstHeaderFixture, ActiveWordTrackListsWithGarbageHeads)
+{
+  constexpr uint64_t kMask = 1UL << 3UL;
+  std::atomic_uint64_t active_word{0};
+  auto *root_addr = pmemobj_direct(pmemobj_root(pop_, sizeof(TLSFields) * 2));
+  list_->SetPMEMInfo(pop_, reinterpret_cast<TLSFields *>(root_addr), &active_word, kMask);
+
+  std::thread loader{[&]() { AddGarbage(kLargeNum); }};
+  loader.join();
+  EXPECT_EQ(active_word.load(), kMask);
+
+  list_->ClearGarbage(kMaxLong);
+  EXPECT_EQ(active_word.load(), 0);
+  CheckGarbage(kLargeNum);
+}
+
+TEST_F(LIstHeaderFixture, AddGarbageAfterOwnerExitsAssignListToNewOwner)
+{
+  constexpr size_t kHalfNum = kBufferSize / 2;
+
+  std::thread{[&]() { AddGarbage(kHalfNum); }}.join();
+  list_->ClearGarbage(kMaxLong);  // the list of the exited owner is released
+  EXPECT_EQ(list_->GetLiveListNum(), 0);
+
+  std::thread{[&]() { AddGarbage(kHalfNum); }}.join();
+  EXPECT_EQ(list_->GetLiveListNum(), 1);
+  list_->ClearGarbage(kMaxLong);
+  EXPECT_EQ(list_->GetLiveListNum(), 0);
+  CheckGarbage(kHalfNum * 2);
+}
+
 TEST_F(LIstHeaderFixture, AddAndClearGarbageWithMultiThreadsReleaseAllGarbage)
 {
   constexpr size_t kLoopNum = 1e5;